@@ -0,0 +1,115 @@
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <android/asset_manager_jni.h>
+
+#include "blob_source.h"
+
+namespace {
+
+// Maps length bytes at offset, which mmap needs page aligned
+void* mapRange(int fd, off_t offset, std::size_t length, std::size_t& mappingSize, const std::uint8_t*& bytes) {
+    auto page = static_cast<off_t>(sysconf(_SC_PAGESIZE));
+    off_t alignedOffset = offset - offset % page;
+    mappingSize = length + static_cast<std::size_t>(offset - alignedOffset);
+    void* mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, fd, alignedOffset);
+    if(mapping == MAP_FAILED) return nullptr;
+    // Read once front to back while the blob is copied
+    madvise(mapping, mappingSize, MADV_SEQUENTIAL);
+    bytes = static_cast<const std::uint8_t*>(mapping) + (offset - alignedOffset);
+    return mapping;
+}
+
+}  // namespace
+
+BlobSource BlobSource::fromFile(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if(fd < 0) throw std::runtime_error("Couldn't open model blob " + path);
+    struct stat info {};
+    BlobSource source;
+    if(fstat(fd, &info) == 0 && info.st_size > 0) {
+        source.length = static_cast<std::size_t>(info.st_size);
+        source.mapping = mapRange(fd, 0, source.length, source.mappingSize, source.bytes);
+    }
+    // The mapping stays valid without the descriptor
+    close(fd);
+    if(source.mapping == nullptr) throw std::runtime_error("Couldn't map model blob " + path);
+    return source;
+}
+
+BlobSource BlobSource::fromAsset(AAssetManager* assetManager, const char* path) {
+    AAsset* asset = assetManager != nullptr ? AAssetManager_open(assetManager, path, AASSET_MODE_BUFFER) : nullptr;
+    if(asset == nullptr) throw std::runtime_error(std::string("Couldn't open model asset ") + path);
+
+    BlobSource source;
+    off_t offset = 0, length = 0;
+    int fd = AAsset_openFileDescriptor(asset, &offset, &length);
+    if(fd >= 0) {
+        source.length = static_cast<std::size_t>(length);
+        source.mapping = mapRange(fd, offset, source.length, source.mappingSize, source.bytes);
+        close(fd);
+    }
+    if(source.mapping != nullptr) {
+        AAsset_close(asset);
+        return source;
+    }
+
+    // Compressed in the APK, the asset inflates it into its own buffer
+    source.asset = asset;
+    source.bytes = static_cast<const std::uint8_t*>(AAsset_getBuffer(asset));
+    source.length = static_cast<std::size_t>(AAsset_getLength(asset));
+    if(source.bytes == nullptr) throw std::runtime_error(std::string("Couldn't read model asset ") + path);
+    return source;
+}
+
+BlobSource BlobSource::fromAsset(JNIEnv* env, jobject activity, const char* path) {
+    return fromAsset(assetManagerOf(env, activity), path);
+}
+
+AAssetManager* BlobSource::assetManagerOf(JNIEnv* env, jobject activity) {
+    jclass clazz = env->GetObjectClass(activity);
+    jmethodID method = env->GetMethodID(clazz, "getAssetManager", "()Landroid/content/res/AssetManager;");
+    jobject jam = env->CallObjectMethod(activity, method);
+    return jam ? AAssetManager_fromJava(env, jam) : nullptr;
+}
+
+BlobSource::BlobSource(BlobSource&& other) noexcept {
+    *this = std::move(other);
+}
+
+BlobSource& BlobSource::operator=(BlobSource&& other) noexcept {
+    if(this != &other) {
+        reset();
+        mapping = other.mapping;
+        mappingSize = other.mappingSize;
+        asset = other.asset;
+        bytes = other.bytes;
+        length = other.length;
+        other.mapping = nullptr;
+        other.asset = nullptr;
+        other.bytes = nullptr;
+        other.mappingSize = other.length = 0;
+    }
+    return *this;
+}
+
+BlobSource::~BlobSource() {
+    reset();
+}
+
+void BlobSource::reset() {
+    if(mapping != nullptr) munmap(mapping, mappingSize);
+    if(asset != nullptr) AAsset_close(asset);
+    mapping = nullptr;
+    asset = nullptr;
+    bytes = nullptr;
+    mappingSize = length = 0;
+}
+
+dai::OpenVINO::Blob BlobSource::toBlob() const {
+    return dai::OpenVINO::Blob(std::vector<std::uint8_t>(bytes, bytes + length));
+}
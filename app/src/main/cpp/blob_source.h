@@ -0,0 +1,60 @@
+#ifndef DEPTHAI_ANDROID_JNI_EXAMPLE_BLOB_SOURCE_H
+#define DEPTHAI_ANDROID_JNI_EXAMPLE_BLOB_SOURCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <jni.h>
+#include <android/asset_manager.h>
+
+#include "depthai/depthai.hpp"
+
+// Read-only bytes of a model blob, memory mapped instead of read into a buffer.
+// Assets are mapped through AAsset_openFileDescriptor, which needs them stored uncompressed
+// (noCompress 'blob' in build.gradle). Compressed assets fall back to AAsset_getBuffer.
+class BlobSource {
+   public:
+    // Throw std::runtime_error if the file or asset can't be opened
+    static BlobSource fromFile(const std::string& path);
+    static BlobSource fromAsset(AAssetManager* assetManager, const char* path);
+    // Asset manager of the activity (its getAssetManager())
+    static BlobSource fromAsset(JNIEnv* env, jobject activity, const char* path);
+    // The activity's asset manager, usable from other threads while the activity exists (JNIEnv isn't)
+    static AAssetManager* assetManagerOf(JNIEnv* env, jobject activity);
+
+    BlobSource(BlobSource&& other) noexcept;
+    BlobSource& operator=(BlobSource&& other) noexcept;
+    BlobSource(const BlobSource&) = delete;
+    BlobSource& operator=(const BlobSource&) = delete;
+    ~BlobSource();
+
+    const std::uint8_t* data() const {
+        return bytes;
+    }
+
+    std::size_t size() const {
+        return length;
+    }
+
+    bool isMapped() const {
+        return mapping != nullptr;
+    }
+
+    // dai::OpenVINO::Blob only takes an owned vector: it is copied from the mapping once, and moved from there on
+    dai::OpenVINO::Blob toBlob() const;
+
+   private:
+    BlobSource() = default;
+    void reset();
+
+    void* mapping = nullptr;
+    std::size_t mappingSize = 0;
+    // Fallback for compressed assets, owns the buffer
+    AAsset* asset = nullptr;
+    const std::uint8_t* bytes = nullptr;
+    std::size_t length = 0;
+};
+
+#endif //DEPTHAI_ANDROID_JNI_EXAMPLE_BLOB_SOURCE_H
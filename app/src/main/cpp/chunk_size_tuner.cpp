@@ -0,0 +1,127 @@
+#include <cinttypes>
+#include <cstdio>
+
+#include "chunk_size_tuner.h"
+
+namespace {
+
+const char* const probeInName = "chunkProbeIn";
+const char* const probeOutName = "chunkProbeOut";
+
+// 64-bit FNV-1a, chain calls through seed to hash several inputs
+std::uint64_t hash(const void* data, std::size_t size, std::uint64_t seed = 14695981039346656037ull) {
+    auto bytes = static_cast<const std::uint8_t*>(data);
+    std::uint64_t value = seed;
+    for(std::size_t i = 0; i < size; i++) {
+        value ^= bytes[i];
+        value *= 1099511628211ull;
+    }
+    return value;
+}
+
+}  // namespace
+
+dai::Pipeline ChunkSizeTuner::probePipeline() const {
+    dai::Pipeline pipeline;
+    auto probeIn = pipeline.create<dai::node::XLinkIn>();
+    auto probeOut = pipeline.create<dai::node::XLinkOut>();
+    probeIn->setStreamName(probeInName);
+    probeIn->setMaxDataSize(static_cast<std::uint32_t>(config.messageBytes));
+    probeIn->setNumFrames(2);
+    probeOut->setStreamName(probeOutName);
+    probeIn->out.link(probeOut->input);
+    return pipeline;
+}
+
+int ChunkSizeTuner::tune(dai::Device& device) {
+    device.startPipeline(probePipeline());
+    auto in = device.getInputQueue(probeInName, 2, true);
+    auto out = device.getOutputQueue(probeOutName, 2, true);
+
+    // Synthetic payload, the same message is sent for every candidate
+    dai::Buffer message;
+    std::vector<std::uint8_t> data(config.messageBytes);
+    for(std::size_t i = 0; i < data.size(); i++) data[i] = static_cast<std::uint8_t>(i * 31);
+    message.setData(std::move(data));
+
+    measurements.clear();
+    const ChunkSizeMeasurement* best = nullptr;
+    for(int candidate : config.candidates) {
+        device.setXLinkChunkSize(candidate);
+        measurements.push_back(measure(*in, *out, message, candidate));
+    }
+    for(const auto& measurement : measurements) {
+        if(measurement.bytesPerSecond > 0 && (!best || measurement.bytesPerSecond > best->bytesPerSecond)) best = &measurement;
+    }
+
+    chunkSize = best ? best->chunkSize : -1;
+    return chunkSize;
+}
+
+ChunkSizeMeasurement ChunkSizeTuner::measure(dai::DataInputQueue& in, dai::DataOutputQueue& out, dai::Buffer& message, int candidate) const {
+    ChunkSizeMeasurement result{candidate, 0.0, std::chrono::microseconds(0)};
+    bool timedOut = false;
+
+    // One message first, so a chunk size change still in flight isn't measured
+    in.send(message);
+    out.get<dai::Buffer>(config.timeout, timedOut);
+    if(timedOut) return result;
+
+    std::chrono::steady_clock::duration total{0};
+    std::size_t bytes = 0;
+    for(int i = 0; i < config.messagesPerCandidate; i++) {
+        auto sent = std::chrono::steady_clock::now();
+        in.send(message);
+        auto echo = out.get<dai::Buffer>(config.timeout, timedOut);
+        if(timedOut || !echo) return result;
+        total += std::chrono::steady_clock::now() - sent;
+        bytes += echo->getData().size();
+    }
+
+    auto seconds = std::chrono::duration<double>(total).count();
+    if(config.messagesPerCandidate > 0 && seconds > 0) {
+        result.bytesPerSecond = static_cast<double>(bytes) / seconds;
+        result.roundTrip = std::chrono::duration_cast<std::chrono::microseconds>(total / config.messagesPerCandidate);
+    }
+    return result;
+}
+
+// Named by a hash of everything the chunk size depends on, a changed input selects another file
+std::string ChunkSizeTuner::cachePath(const std::string& directory, const std::string& mxId, dai::UsbSpeed usbSpeed) const {
+    std::uint64_t key = hash(mxId.data(), mxId.size());
+    auto speed = static_cast<std::int32_t>(usbSpeed);
+    key = hash(&speed, sizeof(speed), key);
+    key = hash(config.candidates.data(), config.candidates.size() * sizeof(int), key);
+    std::uint64_t messageBytes = config.messageBytes;
+    key = hash(&messageBytes, sizeof(messageBytes), key);
+
+    char name[40];
+    std::snprintf(name, sizeof(name), "/chunk-size-%016" PRIx64 ".txt", key);
+    return directory + name;
+}
+
+int ChunkSizeTuner::loadCached(const std::string& directory, const std::string& mxId, dai::UsbSpeed usbSpeed) {
+    measurements.clear();
+    chunkSize = -1;
+    FILE* file = std::fopen(cachePath(directory, mxId, usbSpeed).c_str(), "r");
+    if(file == nullptr) return -1;
+    int cached = -1;
+    if(std::fscanf(file, "%d", &cached) == 1 && cached >= 0) chunkSize = cached;
+    std::fclose(file);
+    return chunkSize;
+}
+
+bool ChunkSizeTuner::storeCached(const std::string& directory, const std::string& mxId, dai::UsbSpeed usbSpeed) const {
+    if(chunkSize < 0) return false;
+    std::string path = cachePath(directory, mxId, usbSpeed);
+    std::string temporary = path + ".tmp";
+    FILE* file = std::fopen(temporary.c_str(), "w");
+    if(file == nullptr) return false;
+    bool ok = std::fprintf(file, "%d\n", chunkSize) > 0;
+    ok = std::fclose(file) == 0 && ok;
+    if(!ok || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,68 @@
+#ifndef DEPTHAI_ANDROID_JNI_EXAMPLE_CHUNK_SIZE_TUNER_H
+#define DEPTHAI_ANDROID_JNI_EXAMPLE_CHUNK_SIZE_TUNER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "depthai/depthai.hpp"
+
+// Throughput of the echo stream with one XLink chunk size
+struct ChunkSizeMeasurement {
+    int chunkSize;
+    // Echoed bytes per second, 0 if the echo timed out
+    double bytesPerSecond;
+    // Mean time from sending a message to receiving its echo
+    std::chrono::microseconds roundTrip;
+};
+
+// Picks the XLink chunk size (Pipeline::setXLinkChunkSize) by measuring, instead of guessing it per
+// phone and USB controller. tune() starts a probe-only pipeline, an XLinkIn -> XLinkOut echo, sends
+// synthetic buffers through it with every candidate and keeps the fastest one. Nothing else runs on
+// the link while measuring, and the app's pipeline doesn't carry the probe.
+class ChunkSizeTuner {
+   public:
+    struct Config {
+        // 0 disables chunking
+        std::vector<int> candidates{16 * 1024, 32 * 1024, 64 * 1024, 128 * 1024, 256 * 1024, 0};
+        // About a 640x400 RGBA frame, all candidates take a second or two over USB 2
+        std::size_t messageBytes = 1024 * 1024;
+        int messagesPerCandidate = 4;
+        std::chrono::milliseconds timeout{2000};
+    };
+
+    ChunkSizeTuner() = default;
+    explicit ChunkSizeTuner(Config config) : config(std::move(config)) {}
+
+    // Measures every candidate on a device that was just booted and hasn't started a pipeline.
+    // Returns the fastest chunk size, or -1 if no candidate got through. A device runs one pipeline
+    // per boot, so it has to be closed and connected again for the app's pipeline.
+    int tune(dai::Device& device);
+
+    // The result of an earlier tune() with the same device, link and probe, kept as a small file in
+    // directory (e.g. the app's cache directory) so warm restarts skip the probe. Returns -1 if there is none.
+    int loadCached(const std::string& directory, const std::string& mxId, dai::UsbSpeed usbSpeed);
+    // Writes the result of tune(), returns false if it couldn't. The file is replaced atomically.
+    bool storeCached(const std::string& directory, const std::string& mxId, dai::UsbSpeed usbSpeed) const;
+
+    int getChunkSize() const {
+        return chunkSize;
+    }
+
+    const std::vector<ChunkSizeMeasurement>& getMeasurements() const {
+        return measurements;
+    }
+
+   private:
+    dai::Pipeline probePipeline() const;
+    std::string cachePath(const std::string& directory, const std::string& mxId, dai::UsbSpeed usbSpeed) const;
+    ChunkSizeMeasurement measure(dai::DataInputQueue& in, dai::DataOutputQueue& out, dai::Buffer& message, int candidate) const;
+
+    Config config;
+    int chunkSize = -1;
+    std::vector<ChunkSizeMeasurement> measurements;
+};
+
+#endif //DEPTHAI_ANDROID_JNI_EXAMPLE_CHUNK_SIZE_TUNER_H
@@ -0,0 +1,7 @@
+#include <algorithm>
+
+#include "device_capabilities.h"
+
+bool DeviceCapabilities::hasCamera(dai::CameraBoardSocket socket) const {
+    return std::find(connectedCameras.begin(), connectedCameras.end(), socket) != connectedCameras.end();
+}
@@ -0,0 +1,60 @@
+#ifndef DEPTHAI_ANDROID_JNI_EXAMPLE_DEVICE_CAPABILITIES_H
+#define DEPTHAI_ANDROID_JNI_EXAMPLE_DEVICE_CAPABILITIES_H
+
+#include <exception>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "depthai-shared/common/CameraBoardSocket.hpp"
+#include "depthai-shared/common/UsbSpeed.hpp"
+
+// What the connected device offers, queried once after connecting. Each of these getters is an RPC
+// to the device, so hot paths (e.g. per frame) read this snapshot instead. Query it again after reconnecting.
+struct DeviceCapabilities {
+    std::string mxId;
+    std::vector<dai::CameraBoardSocket> connectedCameras;
+    std::unordered_map<dai::CameraBoardSocket, std::string> sensorNames;
+    dai::UsbSpeed usbSpeed = dai::UsbSpeed::UNKNOWN;
+    // The EEPROM holds camera calibration
+    bool calibrated = false;
+    std::string boardName;
+
+    // Device is dai::Device, a template so the RPCs can be counted against a fake on the host
+    template <typename Device>
+    static DeviceCapabilities query(Device& device);
+
+    bool hasCamera(dai::CameraBoardSocket socket) const;
+
+    // Left and right mono cameras, i.e. depth is available (OAK-D). Precomputed, for per frame checks.
+    bool hasStereo() const {
+        return stereo;
+    }
+
+   private:
+    bool stereo = false;
+};
+
+template <typename Device>
+DeviceCapabilities DeviceCapabilities::query(Device& device) {
+    DeviceCapabilities capabilities;
+    capabilities.mxId = device.getMxId();
+    capabilities.connectedCameras = device.getConnectedCameras();
+    capabilities.sensorNames = device.getCameraSensorNames();
+    capabilities.usbSpeed = device.getUsbSpeed();
+
+    // Devices without calibration (or with an older EEPROM layout) may fail to read it, with
+    // whichever exception the JSON or EEPROM parsing throws
+    try {
+        auto eeprom = device.readCalibration().getEepromData();
+        capabilities.calibrated = !eeprom.cameraData.empty();
+        capabilities.boardName = eeprom.boardName;
+    } catch(const std::exception&) {
+        capabilities.calibrated = false;
+    }
+
+    capabilities.stereo = capabilities.hasCamera(dai::CameraBoardSocket::LEFT) && capabilities.hasCamera(dai::CameraBoardSocket::RIGHT);
+    return capabilities;
+}
+
+#endif //DEPTHAI_ANDROID_JNI_EXAMPLE_DEVICE_CAPABILITIES_H
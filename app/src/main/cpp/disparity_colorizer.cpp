@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#include "disparity_colorizer.h"
+
+#if defined(__aarch64__)
+    #include <arm_neon.h>
+    #define DISPARITY_COLORIZER_NEON
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+    #define DISPARITY_COLORIZER_X86
+#endif
+
+namespace {
+
+struct Color {
+    uint8_t r, g, b;
+};
+
+uint8_t toByte(float value) {
+    return static_cast<uint8_t>(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+}
+
+// Short rainbow, disparities above the maximum are black
+// Ref: https://www.particleincell.com/2014/colormap
+Color rainbow(float t) {
+    auto a = (1.0f - t) * 5.0f;
+    auto X = (int)floor(a);
+    auto Y = (uint8_t)(255 * (a - X));
+    switch(X) {
+        case 0: return {255, Y, 0};
+        case 1: return {(uint8_t)(255 - Y), 255, 0};
+        case 2: return {0, 255, Y};
+        case 3: return {0, (uint8_t)(255 - Y), 255};
+        case 4: return {Y, 0, 255};
+        case 5: return {255, 0, 255};
+        default: return {0, 0, 0};
+    }
+}
+
+Color jet(float t) {
+    return {toByte(1.5f - std::fabs(4.0f * t - 3.0f)), toByte(1.5f - std::fabs(4.0f * t - 2.0f)), toByte(1.5f - std::fabs(4.0f * t - 1.0f))};
+}
+
+// Polynomial approximation of Turbo
+// Ref: https://ai.googleblog.com/2019/08/turbo-improved-rainbow-colormap-for.html
+Color turbo(float t) {
+    float r = 0.13572138f + t * (4.61539260f + t * (-42.66032258f + t * (132.13108234f + t * (-152.94239396f + t * 59.28637943f))));
+    float g = 0.09140261f + t * (2.19418839f + t * (4.84296658f + t * (-14.18503333f + t * (4.27729857f + t * 2.82956604f))));
+    float b = 0.10667330f + t * (12.64194608f + t * (-60.58204836f + t * (110.36276771f + t * (-89.90310912f + t * 27.34824973f))));
+    return {toByte(r), toByte(g), toByte(b)};
+}
+
+Color gray(float t) {
+    auto v = toByte(t);
+    return {v, v, v};
+}
+
+// RGBA byte order in memory (little endian)
+uint32_t toRgba(Color c) {
+    return c.r | (c.g << 8) | (c.b << 16) | (0xFFu << 24);
+}
+
+Color applyColormap(Colormap colormap, float t) {
+    switch(colormap) {
+        case Colormap::JET: return jet(std::min(t, 1.0f));
+        case Colormap::TURBO: return turbo(std::min(t, 1.0f));
+        case Colormap::GRAY: return gray(std::min(t, 1.0f));
+        case Colormap::RAINBOW:
+        default: return rainbow(t);
+    }
+}
+
+}  // namespace
+
+void DisparityColorizer::configure(float maxDisparity, Colormap colormap) {
+    if(configured && maxDisparity == this->maxDisparity && colormap == this->colormap) return;
+
+    for(int d = 0; d < 256; d++) {
+        Color c = applyColormap(colormap, d / maxDisparity);
+        channels[0][d] = c.r;
+        channels[1][d] = c.g;
+        channels[2][d] = c.b;
+        rgba[d] = toRgba(c);
+    }
+
+    size_t levels = static_cast<size_t>(std::max(maxDisparity, 0.0f)) + 2;
+    rgba16.resize(std::min<size_t>(levels, 65536));
+    for(size_t d = 0; d < rgba16.size(); d++) {
+        rgba16[d] = toRgba(applyColormap(colormap, d / maxDisparity));
+    }
+
+    this->maxDisparity = maxDisparity;
+    this->colormap = colormap;
+    configured = true;
+}
+
+namespace {
+
+void colorizeScalar(const uint32_t* rgba, const uint8_t (*)[256], const uint8_t* disparity, uint8_t* dst, size_t pixels) {
+    for(size_t i = 0; i < pixels; i++) {
+        std::memcpy(dst + 4 * i, &rgba[disparity[i]], 4);
+    }
+}
+
+void colorize16Scalar(const uint32_t* rgba16, uint32_t last, const uint16_t* disparity, uint8_t* dst, size_t pixels) {
+    for(size_t i = 0; i < pixels; i++) {
+        std::memcpy(dst + 4 * i, &rgba16[std::min<uint32_t>(disparity[i], last)], 4);
+    }
+}
+
+#if defined(DISPARITY_COLORIZER_NEON)
+
+uint8x16_t lookup256(const uint8x16x4_t table[4], uint8x16_t index) {
+    // Each TBL covers 64 entries, indices outside of the range keep the previous result (TBX)
+    const uint8x16_t step = vdupq_n_u8(64);
+    uint8x16_t result = vqtbl4q_u8(table[0], index);
+    index = vsubq_u8(index, step);
+    result = vqtbx4q_u8(result, table[1], index);
+    index = vsubq_u8(index, step);
+    result = vqtbx4q_u8(result, table[2], index);
+    index = vsubq_u8(index, step);
+    return vqtbx4q_u8(result, table[3], index);
+}
+
+void colorizeNeon(const uint32_t* rgba, const uint8_t (*channels)[256], const uint8_t* disparity, uint8_t* dst, size_t pixels) {
+    uint8x16x4_t tables[3][4];
+    for(int c = 0; c < 3; c++) {
+        for(int t = 0; t < 4; t++) {
+            const uint8_t* entries = channels[c] + 64 * t;
+            tables[c][t] = {{vld1q_u8(entries), vld1q_u8(entries + 16), vld1q_u8(entries + 32), vld1q_u8(entries + 48)}};
+        }
+    }
+
+    size_t i = 0;
+    for(; i + 16 <= pixels; i += 16) {
+        uint8x16_t index = vld1q_u8(disparity + i);
+        uint8x16x4_t out;
+        out.val[0] = lookup256(tables[0], index);
+        out.val[1] = lookup256(tables[1], index);
+        out.val[2] = lookup256(tables[2], index);
+        out.val[3] = vdupq_n_u8(255);
+        vst4q_u8(dst + 4 * i, out);
+    }
+
+    colorizeScalar(rgba, channels, disparity + i, dst + 4 * i, pixels - i);
+}
+
+#elif defined(DISPARITY_COLORIZER_X86)
+
+__attribute__((target("avx2"))) void colorizeAvx2(const uint32_t* rgba, const uint8_t (*channels)[256], const uint8_t* disparity, uint8_t* dst,
+                                                  size_t pixels) {
+    size_t i = 0;
+    for(; i + 8 <= pixels; i += 8) {
+        __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(disparity + i));
+        __m256i index = _mm256_cvtepu8_epi32(bytes);
+        __m256i out = _mm256_i32gather_epi32(reinterpret_cast<const int*>(rgba), index, 4);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 4 * i), out);
+    }
+
+    colorizeScalar(rgba, channels, disparity + i, dst + 4 * i, pixels - i);
+}
+
+__attribute__((target("avx2"))) void colorize16Avx2(const uint32_t* rgba16, uint32_t last, const uint16_t* disparity, uint8_t* dst, size_t pixels) {
+    const __m256i maxIndex = _mm256_set1_epi32(static_cast<int>(last));
+    size_t i = 0;
+    for(; i + 8 <= pixels; i += 8) {
+        __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(disparity + i));
+        __m256i index = _mm256_min_epu32(_mm256_cvtepu16_epi32(words), maxIndex);
+        __m256i out = _mm256_i32gather_epi32(reinterpret_cast<const int*>(rgba16), index, 4);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 4 * i), out);
+    }
+
+    colorize16Scalar(rgba16, last, disparity + i, dst + 4 * i, pixels - i);
+}
+
+#endif
+
+const ColorizeKernels& selectedKernels() {
+    static const ColorizeKernels kernels = availableColorizeKernels().front();
+    return kernels;
+}
+
+}  // namespace
+
+std::vector<ColorizeKernels> availableColorizeKernels() {
+    std::vector<ColorizeKernels> kernels;
+#if defined(DISPARITY_COLORIZER_NEON)
+    // The 16-bit table is too large for TBL, RAW16 uses the scalar lookup
+    kernels.push_back({colorizeNeon, colorize16Scalar, "neon"});
+#elif defined(DISPARITY_COLORIZER_X86)
+    if(__builtin_cpu_supports("avx2")) kernels.push_back({colorizeAvx2, colorize16Avx2, "avx2"});
+#endif
+    kernels.push_back({colorizeScalar, colorize16Scalar, "scalar"});
+    return kernels;
+}
+
+void DisparityColorizer::colorize(const uint8_t* disparity, uint8_t* dst, size_t pixels) const {
+    colorize(disparity, dst, pixels, selectedKernels());
+}
+
+void DisparityColorizer::colorize(const uint16_t* disparity, uint8_t* dst, size_t pixels) const {
+    colorize(disparity, dst, pixels, selectedKernels());
+}
+
+void DisparityColorizer::colorize(const uint8_t* disparity, uint8_t* dst, size_t pixels, const ColorizeKernels& kernels) const {
+    if(!configured) throw std::runtime_error("DisparityColorizer used before configure()");
+    kernels.raw8(rgba, channels, disparity, dst, pixels);
+}
+
+void DisparityColorizer::colorize(const uint16_t* disparity, uint8_t* dst, size_t pixels, const ColorizeKernels& kernels) const {
+    // rgba16 is empty until then, last would wrap around
+    if(!configured) throw std::runtime_error("DisparityColorizer used before configure()");
+    kernels.raw16(rgba16.data(), static_cast<uint32_t>(rgba16.size() - 1), disparity, dst, pixels);
+}
@@ -0,0 +1,67 @@
+#ifndef DEPTHAI_ANDROID_JNI_EXAMPLE_DISPARITY_COLORIZER_H
+#define DEPTHAI_ANDROID_JNI_EXAMPLE_DISPARITY_COLORIZER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Colormaps for the disparity image, keep in sync with the constants in MainActivity
+enum class Colormap {
+    RAINBOW = 0,  // Short rainbow (particleincell.com colormap)
+    JET = 1,
+    TURBO = 2,
+    GRAY = 3
+};
+
+// One implementation of the table lookups. raw8 reads rgba (256 RGBA words) or the per channel tables,
+// raw16 reads rgba16 and clamps the disparities to last.
+struct ColorizeKernels {
+    void (*raw8)(const uint32_t* rgba, const uint8_t (*channels)[256], const uint8_t* disparity, uint8_t* dst, size_t pixels);
+    void (*raw16)(const uint32_t* rgba16, uint32_t last, const uint16_t* disparity, uint8_t* dst, size_t pixels);
+    const char* name;
+};
+
+// Every kernel set this CPU supports, the one colorize() uses first and the scalar one last.
+// For testing and benchmarking the vector kernels against each other.
+std::vector<ColorizeKernels> availableColorizeKernels();
+
+// Colors disparity frames through a precomputed table of RGBA pixels.
+// The table only depends on the disparity range and the colormap, so it is rebuilt
+// when those change (configure) instead of evaluating the colormap for every pixel.
+// maxDisparity is in output units, e.g. 760 for subpixel disparity with 3 fractional bits.
+class DisparityColorizer {
+   public:
+    // Rebuilds the tables if the maximum disparity or the colormap changed
+    void configure(float maxDisparity, Colormap colormap);
+
+    // Writes one RGBA pixel (4 bytes) per 8-bit disparity value (RAW8, standard and extended mode).
+    // Both overloads throw std::runtime_error before the first configure().
+    void colorize(const uint8_t* disparity, uint8_t* dst, size_t pixels) const;
+
+    // Writes one RGBA pixel (4 bytes) per 16-bit disparity value (RAW16, subpixel mode)
+    void colorize(const uint16_t* disparity, uint8_t* dst, size_t pixels) const;
+
+    // Same, with the given kernels instead of the ones selected at runtime
+    void colorize(const uint8_t* disparity, uint8_t* dst, size_t pixels, const ColorizeKernels& kernels) const;
+    void colorize(const uint16_t* disparity, uint8_t* dst, size_t pixels, const ColorizeKernels& kernels) const;
+
+    // False until the first configure(), the tables are empty before
+    bool isConfigured() const { return configured; }
+    float getMaxDisparity() const { return maxDisparity; }
+    Colormap getColormap() const { return colormap; }
+
+   private:
+    float maxDisparity = 0.0f;
+    Colormap colormap = Colormap::RAINBOW;
+    bool configured = false;
+
+    // RGBA bytes of every disparity value, packed as one word and split per channel
+    // (the channel tables feed the NEON table lookup)
+    alignas(16) uint32_t rgba[256] = {};
+    alignas(16) uint8_t channels[3][256] = {};
+
+    // RGBA words for 16-bit disparities up to maxDisparity, the last entry is used for anything above it
+    std::vector<uint32_t> rgba16;
+};
+
+#endif //DEPTHAI_ANDROID_JNI_EXAMPLE_DISPARITY_COLORIZER_H
@@ -0,0 +1,241 @@
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <opencv2/imgproc.hpp>
+
+#include "frame_converter.h"
+#include "pixel_pack.h"
+
+namespace {
+
+// Frame types converted to RGB, others are copied as they are
+bool isColorType(dai::RawImgFrame::Type type) {
+    switch(type) {
+        case dai::RawImgFrame::Type::RGB888i:
+        case dai::RawImgFrame::Type::BGR888i:
+        case dai::RawImgFrame::Type::RGB888p:
+        case dai::RawImgFrame::Type::BGR888p:
+        case dai::RawImgFrame::Type::YUV420p:
+        case dai::RawImgFrame::Type::NV12:
+        case dai::RawImgFrame::Type::NV21:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+// Mat header over the frame data, for the types convert() copies as they are
+cv::Mat getFrame(const dai::RawImgFrame& frame) {
+    cv::Mat mat;
+    cv::Size size = {0, 0};
+    int type = 0;
+    int width = static_cast<int>(frame.fb.width);
+    int height = static_cast<int>(frame.fb.height);
+
+    switch(frame.fb.type) {
+        case dai::RawImgFrame::Type::RAW8:
+        case dai::RawImgFrame::Type::GRAY8:
+            size = cv::Size(width, height);
+            type = CV_8UC1;
+            break;
+
+        case dai::RawImgFrame::Type::GRAYF16:
+            size = cv::Size(width, height);
+            type = CV_16FC1;
+            break;
+
+        case dai::RawImgFrame::Type::RAW16:
+            size = cv::Size(width, height);
+            type = CV_16UC1;
+            break;
+
+        case dai::RawImgFrame::Type::RGBF16F16F16i:
+        case dai::RawImgFrame::Type::BGRF16F16F16i:
+        case dai::RawImgFrame::Type::RGBF16F16F16p:
+        case dai::RawImgFrame::Type::BGRF16F16F16p:
+            size = cv::Size(width, height);
+            type = CV_16FC3;
+            break;
+
+        case dai::RawImgFrame::Type::BITSTREAM:
+        default:
+            size = cv::Size(static_cast<int>(frame.data.size()), 1);
+            type = CV_8UC1;
+            break;
+    }
+
+    // Check if enough data, honoring the row stride and plane offsets
+    FrameView view(frame);
+    const FramePlane& plane = view.plane(0);
+
+    if(view.planeCount() == 1) {
+        mat = cv::Mat(size, type, const_cast<uint8_t*>(plane.data), plane.stride);
+    } else if(view.isContiguous()) {
+        mat = cv::Mat(size, type, const_cast<uint8_t*>(plane.data));
+    } else {
+        throw std::runtime_error("ImgFrame planes are not contiguous, read them through FrameView");
+    }
+
+    return mat;
+}
+
+}  // namespace
+
+FrameConverter::FrameConverter(size_t ringSize) : ring(std::max<size_t>(ringSize, 1)) {}
+
+cv::Mat FrameConverter::convert(const std::shared_ptr<dai::ImgFrame>& imgFrame) {
+    return convert(*std::static_pointer_cast<dai::RawImgFrame>(imgFrame->getRaw()));
+}
+
+// Converts into the preallocated slot.
+// Color frames are read plane by plane through FrameView, so padded rows need no repacking.
+cv::Mat FrameConverter::convert(const dai::RawImgFrame& frame) {
+    FrameView view(frame);
+    bool color = isColorType(frame.fb.type);
+    cv::Mat input = color ? cv::Mat() : getFrame(frame);
+
+    Slot& slot = ring[next];
+    next = (next + 1) % ring.size();
+
+    // Size the output buffer only when the frame format changes
+    if(slot.type != frame.fb.type || slot.width != frame.fb.width || slot.height != frame.fb.height || slot.output.empty()) {
+        if(color) {
+            slot.output.create(static_cast<int>(view.height()), static_cast<int>(view.width()), CV_8UC3);
+        } else {
+            slot.output.create(input.size(), input.type());
+        }
+        slot.type = frame.fb.type;
+        slot.width = frame.fb.width;
+        slot.height = frame.fb.height;
+    }
+    cv::Mat& output = slot.output;
+
+    switch(frame.fb.type) {
+        case dai::RawImgFrame::Type::RGB888i:
+            view.planeMat(0, CV_8UC3).copyTo(output);
+            break;
+
+        case dai::RawImgFrame::Type::BGR888i:
+            cv::cvtColor(view.planeMat(0, CV_8UC3), output, cv::ColorConversionCodes::COLOR_BGR2RGB);
+            break;
+
+        case dai::RawImgFrame::Type::RGB888p:
+        case dai::RawImgFrame::Type::BGR888p: {
+            bool bgr = frame.fb.type == dai::RawImgFrame::Type::BGR888p;
+            // Channel headers on the stack, merged in RGB order
+            cv::Mat channels[3] = {view.planeMat(bgr ? 2 : 0, CV_8UC1), view.planeMat(1, CV_8UC1), view.planeMat(bgr ? 0 : 2, CV_8UC1)};
+            cv::merge(channels, 3, output);
+        } break;
+
+        case dai::RawImgFrame::Type::YUV420p:
+            cv::cvtColor(contiguousYuv420(view), output, cv::ColorConversionCodes::COLOR_YUV2RGB_IYUV);
+            break;
+
+        case dai::RawImgFrame::Type::NV12:
+            cv::cvtColorTwoPlane(view.planeMat(0, CV_8UC1), view.planeMat(1, CV_8UC2), output, cv::ColorConversionCodes::COLOR_YUV2RGB_NV12);
+            break;
+
+        case dai::RawImgFrame::Type::NV21:
+            cv::cvtColorTwoPlane(view.planeMat(0, CV_8UC1), view.planeMat(1, CV_8UC2), output, cv::ColorConversionCodes::COLOR_YUV2RGB_NV21);
+            break;
+
+        default:
+            input.copyTo(output);
+            break;
+    }
+
+    return output;
+}
+
+cv::Mat FrameConverter::contiguousYuv420(const FrameView& view) {
+    int rows = static_cast<int>(view.height() * 3 / 2);
+    int cols = static_cast<int>(view.width());
+    if(view.isContiguous()) {
+        return cv::Mat(rows, cols, CV_8UC1, const_cast<uint8_t*>(view.plane(0).data));
+    }
+
+    // OpenCV has no three plane YUV conversion, gather the padded planes once into the scratch buffer
+    yuvScratch.create(rows, cols, CV_8UC1);
+    uint8_t* dst = yuvScratch.data;
+    for(int i = 0; i < view.planeCount(); i++) {
+        const FramePlane& plane = view.plane(i);
+        for(unsigned int y = 0; y < plane.rows; y++) {
+            std::memcpy(dst, plane.row(y), plane.rowBytes);
+            dst += plane.rowBytes;
+        }
+    }
+    return yuvScratch;
+}
+
+void FrameConverter::convertToRgba(const std::shared_ptr<dai::ImgFrame>& imgFrame, uint8_t* dst) {
+    convertToRgba(*std::static_pointer_cast<dai::RawImgFrame>(imgFrame->getRaw()), dst);
+}
+
+void FrameConverter::convertToRgba(const dai::RawImgFrame& frame, uint8_t* dst) {
+    switch(frame.fb.type) {
+        case dai::RawImgFrame::Type::RGB888p:
+        case dai::RawImgFrame::Type::BGR888p: {
+            // Planes are read in place, no interleaved intermediate image
+            FrameView view(frame);
+            const FramePlane& p1 = view.plane(0);
+            const FramePlane& p2 = view.plane(1);
+            const FramePlane& p3 = view.plane(2);
+            if(frame.fb.type == dai::RawImgFrame::Type::RGB888p) {
+                packPlanarImageToRgba(p1.data, p2.data, p3.data, p1.stride, view.width(), view.height(), dst, view.width() * 4);
+            } else {
+                packPlanarImageToRgba(p3.data, p2.data, p1.data, p1.stride, view.width(), view.height(), dst, view.width() * 4);
+            }
+        } return;
+
+        case dai::RawImgFrame::Type::RGB888i:
+        case dai::RawImgFrame::Type::BGR888i: {
+            FrameView view(frame);
+            const FramePlane& plane = view.plane(0);
+            auto order = frame.fb.type == dai::RawImgFrame::Type::RGB888i ? PixelOrder::RGB : PixelOrder::BGR;
+            if(plane.isPacked()) {
+                packInterleavedToRgba(plane.data, dst, view.width() * view.height(), order);
+            } else {
+                for(unsigned int y = 0; y < plane.rows; y++) {
+                    packInterleavedToRgba(plane.row(y), dst + y * view.width() * 4, view.width(), order);
+                }
+            }
+        } return;
+
+        case dai::RawImgFrame::Type::RAW8:
+        case dai::RawImgFrame::Type::GRAY8:
+        case dai::RawImgFrame::Type::YUV400p: {
+            FrameView view(frame);
+            const FramePlane& plane = view.plane(0);
+            for(unsigned int y = 0; y < plane.rows; y++) {
+                packGrayToRgba(plane.row(y), dst + y * view.width() * 4, view.width());
+            }
+        } return;
+
+        case dai::RawImgFrame::Type::RAW16: {
+            if(disparityColorizer == nullptr || !disparityColorizer->isConfigured()) {
+                throw std::runtime_error("RAW16 frames need a configured disparity colorizer");
+            }
+            FrameView view(frame);
+            const FramePlane& plane = view.plane(0);
+            for(unsigned int y = 0; y < plane.rows; y++) {
+                disparityColorizer->colorize(reinterpret_cast<const uint16_t*>(plane.row(y)), dst + y * view.width() * 4, view.width());
+            }
+        } return;
+
+        case dai::RawImgFrame::Type::YUV420p:
+        case dai::RawImgFrame::Type::NV12:
+        case dai::RawImgFrame::Type::NV21:
+            break;
+
+        default:
+            throw std::runtime_error("Can't convert ImgFrame type " + std::to_string(static_cast<int>(frame.fb.type)) + " to RGBA");
+    }
+
+    cv::Mat rgb = convert(frame);
+    if(rgb.type() != CV_8UC3 || !rgb.isContinuous()) {
+        throw std::runtime_error("Converted frame is not a packed RGB image");
+    }
+    packInterleavedToRgba(rgb.data, dst, rgb.total(), PixelOrder::RGB);
+}
@@ -0,0 +1,53 @@
+#ifndef DEPTHAI_ANDROID_JNI_EXAMPLE_FRAME_CONVERTER_H
+#define DEPTHAI_ANDROID_JNI_EXAMPLE_FRAME_CONVERTER_H
+
+#include <memory>
+#include <vector>
+
+#include "opencv2/core.hpp"
+#include "depthai/depthai.hpp"
+
+#include "disparity_colorizer.h"
+#include "frame_view.h"
+
+// Reusable conversion context for ImgFrames.
+// Converts into a small ring of output buffers that are sized once per (type, width, height),
+// so streaming frames of the same format does not allocate.
+class FrameConverter {
+   public:
+    explicit FrameConverter(size_t ringSize = 2);
+
+    // Converts the frame to an RGB (or single channel for RAW/GRAY types) image.
+    // The returned Mat shares its data with the ring, it is overwritten ringSize conversions later.
+    cv::Mat convert(const dai::RawImgFrame& frame);
+    cv::Mat convert(const std::shared_ptr<dai::ImgFrame>& imgFrame);
+
+    // Writes the frame as RGBA bytes (width * height * 4) into dst.
+    // Planar and interleaved 8-bit RGB/BGR frames are packed directly from the frame planes, YUV frames
+    // go through convert() first. 8-bit gray frames are replicated into the color channels and RAW16 frames
+    // (disparity or depth) are colored by the disparity colorizer. Throws std::runtime_error for other types
+    // (float, RAW10-14, bitstream), or for RAW16 without a configured colorizer.
+    void convertToRgba(const dai::RawImgFrame& frame, uint8_t* dst);
+    void convertToRgba(const std::shared_ptr<dai::ImgFrame>& imgFrame, uint8_t* dst);
+
+    // Colors RAW16 frames in convertToRgba, not owned
+    void setDisparityColorizer(const DisparityColorizer* colorizer) { disparityColorizer = colorizer; }
+
+   private:
+    struct Slot {
+        dai::RawImgFrame::Type type = dai::RawImgFrame::Type::NONE;
+        unsigned int width = 0;
+        unsigned int height = 0;
+        cv::Mat output;
+    };
+
+    // YUV420p planes gathered into one buffer, only for frames with padded planes
+    cv::Mat contiguousYuv420(const FrameView& view);
+
+    std::vector<Slot> ring;
+    size_t next = 0;
+    cv::Mat yuvScratch;
+    const DisparityColorizer* disparityColorizer = nullptr;
+};
+
+#endif //DEPTHAI_ANDROID_JNI_EXAMPLE_FRAME_CONVERTER_H
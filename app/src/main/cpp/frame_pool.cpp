@@ -0,0 +1,25 @@
+#include "frame_pool.h"
+
+FramePool::FramePool(JNIEnv* env, int numSlots, size_t slotBytes) : FrameSlots(numSlots, slotBytes) {
+    for(int i = 0; i < numSlots; i++) {
+        jobject buffer = env->NewDirectByteBuffer(data(i), static_cast<jlong>(slotBytes));
+        byteBuffers.push_back(env->NewGlobalRef(buffer));
+        env->DeleteLocalRef(buffer);
+    }
+}
+
+jobjectArray FramePool::buffers(JNIEnv* env) const {
+    jclass byteBufferClass = env->FindClass("java/nio/ByteBuffer");
+    jobjectArray result = env->NewObjectArray(size(), byteBufferClass, nullptr);
+    for(int i = 0; i < size(); i++) {
+        env->SetObjectArrayElement(result, i, byteBuffers[i]);
+    }
+    return result;
+}
+
+void FramePool::destroy(JNIEnv* env) {
+    for(auto& buffer : byteBuffers) {
+        env->DeleteGlobalRef(buffer);
+    }
+    byteBuffers.clear();
+}
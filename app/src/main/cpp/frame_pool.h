@@ -0,0 +1,35 @@
+#ifndef DEPTHAI_ANDROID_JNI_EXAMPLE_FRAME_POOL_H
+#define DEPTHAI_ANDROID_JNI_EXAMPLE_FRAME_POOL_H
+
+#include <jni.h>
+#include <vector>
+
+#include "frame_slots.h"
+
+// Streams that own a frame pool, keep in sync with the constants in MainActivity
+enum FrameStream {
+    FRAME_STREAM_RGB = 0,
+    FRAME_STREAM_DEPTH = 1,
+    FRAME_STREAM_RAW_DEPTH = 2,
+    FRAME_STREAM_COUNT
+};
+
+// Frame slots shared with Java as direct ByteBuffers.
+// Native code fills a slot in place and hands its index to Java, which copies it into
+// the Bitmap (copyPixelsFromBuffer) and gives it back with release(). The ByteBuffers are
+// created once, so the per-frame path does no JNI allocation.
+class FramePool : public FrameSlots {
+   public:
+    FramePool(JNIEnv* env, int numSlots, size_t slotBytes);
+
+    // Array of java.nio.ByteBuffer wrapping every slot, indexed by slot number
+    jobjectArray buffers(JNIEnv* env) const;
+
+    // Deletes the global references, must be called before the pool is destroyed
+    void destroy(JNIEnv* env);
+
+   private:
+    std::vector<jobject> byteBuffers;
+};
+
+#endif //DEPTHAI_ANDROID_JNI_EXAMPLE_FRAME_POOL_H
@@ -0,0 +1,43 @@
+#include <stdexcept>
+
+#include "frame_slots.h"
+
+FrameSlots::FrameSlots(int numSlots, size_t slotBytes) : bytesPerSlot(slotBytes) {
+    if(numSlots < 2) {
+        throw std::invalid_argument("FrameSlots needs at least two slots");
+    }
+
+    storage.resize(numSlots);
+    inUse.reset(new std::atomic<bool>[numSlots]);
+    for(int i = 0; i < numSlots; i++) {
+        storage[i].resize(slotBytes);
+        inUse[i] = false;
+    }
+}
+
+int FrameSlots::acquire() {
+    int numSlots = size();
+    int start = nextSlot.load();
+    int skip = latestSlot.load();
+
+    for(int i = 0; i < numSlots; i++) {
+        int slot = (start + i) % numSlots;
+        if(slot == skip) continue;
+
+        bool expected = false;
+        if(inUse[slot].compare_exchange_strong(expected, true)) {
+            nextSlot = (slot + 1) % numSlots;
+            return slot;
+        }
+    }
+    return -1;
+}
+
+void FrameSlots::publish(int slot) {
+    latestSlot = slot;
+}
+
+void FrameSlots::release(int slot) {
+    if(slot < 0 || slot >= size()) return;
+    inUse[slot] = false;
+}
@@ -0,0 +1,40 @@
+#ifndef DEPTHAI_ANDROID_JNI_EXAMPLE_FRAME_SLOTS_H
+#define DEPTHAI_ANDROID_JNI_EXAMPLE_FRAME_SLOTS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Fixed set of frame buffers handed from a producer to a consumer by slot index.
+// The producer fills a free slot in place and publishes it, the consumer gives it back with release().
+class FrameSlots {
+   public:
+    FrameSlots(int numSlots, size_t slotBytes);
+    FrameSlots(const FrameSlots&) = delete;
+    FrameSlots& operator=(const FrameSlots&) = delete;
+
+    // Returns a free slot marked as in use, or -1 if the consumer still holds all of them.
+    // The most recently published slot is never returned, so it stays readable by the producer.
+    int acquire();
+    // Marks the slot as the latest frame, it stays in use until the consumer releases it
+    void publish(int slot);
+    // Called once the consumer has copied the slot, or to drop a slot that was never published
+    void release(int slot);
+
+    int latest() const { return latestSlot.load(); }
+    uint8_t* data(int slot) { return storage[slot].data(); }
+    const uint8_t* data(int slot) const { return storage[slot].data(); }
+    size_t slotBytes() const { return bytesPerSlot; }
+    int size() const { return static_cast<int>(storage.size()); }
+
+   private:
+    size_t bytesPerSlot;
+    std::vector<std::vector<uint8_t>> storage;
+    std::unique_ptr<std::atomic<bool>[]> inUse;
+    std::atomic<int> latestSlot{-1};
+    std::atomic<int> nextSlot{0};
+};
+
+#endif //DEPTHAI_ANDROID_JNI_EXAMPLE_FRAME_SLOTS_H
@@ -0,0 +1,130 @@
+#include <stdexcept>
+#include <string>
+
+#include "frame_view.h"
+
+namespace {
+
+// Plane layout of a frame type relative to the luma/first plane stride
+struct PlaneLayout {
+    size_t bytesPerPixel;  // bytes of one pixel in the plane's row
+    unsigned int widthDivisor;
+    unsigned int heightDivisor;
+    unsigned int strideDivisor;
+};
+
+int planeLayouts(dai::RawImgFrame::Type type, PlaneLayout layouts[FrameView::maxPlanes]) {
+    using Type = dai::RawImgFrame::Type;
+    switch(type) {
+        case Type::RGB888i:
+        case Type::BGR888i:
+            layouts[0] = {3, 1, 1, 1};
+            return 1;
+
+        case Type::RGB888p:
+        case Type::BGR888p:
+            layouts[0] = layouts[1] = layouts[2] = {1, 1, 1, 1};
+            return 3;
+
+        case Type::RGBF16F16F16i:
+        case Type::BGRF16F16F16i:
+            layouts[0] = {6, 1, 1, 1};
+            return 1;
+
+        case Type::RGBF16F16F16p:
+        case Type::BGRF16F16F16p:
+            layouts[0] = layouts[1] = layouts[2] = {2, 1, 1, 1};
+            return 3;
+
+        case Type::NV12:
+        case Type::NV21:
+            // Interleaved chroma at half the height, same row pitch as luma
+            layouts[0] = {1, 1, 1, 1};
+            layouts[1] = {1, 1, 2, 1};
+            return 2;
+
+        case Type::YUV420p:
+            layouts[0] = {1, 1, 1, 1};
+            layouts[1] = layouts[2] = {1, 2, 2, 2};
+            return 3;
+
+        case Type::RAW8:
+        case Type::GRAY8:
+        case Type::YUV400p:
+            layouts[0] = {1, 1, 1, 1};
+            return 1;
+
+        case Type::RAW16:
+        case Type::RAW14:
+        case Type::RAW12:
+        case Type::RAW10:
+        case Type::GRAYF16:
+            layouts[0] = {2, 1, 1, 1};
+            return 1;
+
+        default:
+            return 0;
+    }
+}
+
+}  // namespace
+
+FrameView::FrameView(const dai::RawImgFrame& frame)
+    : frameType(frame.fb.type), frameWidth(frame.fb.width), frameHeight(frame.fb.height) {
+
+    const uint8_t* data = frame.data.data();
+    size_t size = frame.data.size();
+
+    PlaneLayout layouts[maxPlanes];
+    numPlanes = planeLayouts(frameType, layouts);
+
+    // Bitstreams and unknown types are exposed as one row holding all the data
+    if(numPlanes == 0) {
+        planes[0] = {data, size, size, 1};
+        numPlanes = 1;
+        return;
+    }
+
+    if(frameWidth == 0 || frameHeight == 0) {
+        throw std::runtime_error("ImgFrame metadata not valid (width or height = 0)");
+    }
+
+    size_t firstRowBytes = frameWidth * layouts[0].bytesPerPixel;
+    size_t stride = frame.fb.stride ? frame.fb.stride : firstRowBytes;
+    const unsigned int offsets[maxPlanes] = {frame.fb.p1Offset, frame.fb.p2Offset, frame.fb.p3Offset};
+
+    size_t nextOffset = offsets[0];
+    for(int i = 0; i < numPlanes; i++) {
+        const PlaneLayout& layout = layouts[i];
+        FramePlane& plane = planes[i];
+        plane.rowBytes = frameWidth / layout.widthDivisor * layout.bytesPerPixel;
+        plane.stride = stride / layout.strideDivisor;
+        plane.rows = frameHeight / layout.heightDivisor;
+
+        // Offsets left at 0 (e.g. frames built on the host) mean the planes directly follow each other
+        size_t offset = (i == 0 || offsets[i] != 0) ? offsets[i] : nextOffset;
+        size_t end = offset + plane.stride * (plane.rows - 1) + plane.rowBytes;
+        if(plane.stride < plane.rowBytes || end > size) {
+            throw std::runtime_error("ImgFrame doesn't have enough data for plane " + std::to_string(i) + ", required " + std::to_string(end)
+                                     + ", actual " + std::to_string(size) + ". Maybe metadataOnly transfer was made?");
+        }
+        plane.data = data + offset;
+        nextOffset = offset + plane.stride * plane.rows;
+    }
+}
+
+FrameView::FrameView(const std::shared_ptr<dai::ImgFrame>& imgFrame) : FrameView(*std::static_pointer_cast<dai::RawImgFrame>(imgFrame->getRaw())) {}
+
+bool FrameView::isContiguous() const {
+    for(int i = 0; i < numPlanes; i++) {
+        if(!planes[i].isPacked()) return false;
+        if(i > 0 && planes[i].data != planes[i - 1].data + planes[i - 1].stride * planes[i - 1].rows) return false;
+    }
+    return true;
+}
+
+cv::Mat FrameView::planeMat(int index, int cvType) const {
+    const FramePlane& p = planes[index];
+    int cols = static_cast<int>(p.rowBytes / CV_ELEM_SIZE(cvType));
+    return cv::Mat(static_cast<int>(p.rows), cols, cvType, const_cast<uint8_t*>(p.data), p.stride);
+}
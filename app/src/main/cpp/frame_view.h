@@ -0,0 +1,53 @@
+#ifndef DEPTHAI_ANDROID_JNI_EXAMPLE_FRAME_VIEW_H
+#define DEPTHAI_ANDROID_JNI_EXAMPLE_FRAME_VIEW_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "opencv2/core.hpp"
+#include "depthai/depthai.hpp"
+
+// One plane of a frame: first row, row pitch and size of a row in bytes
+struct FramePlane {
+    const uint8_t* data = nullptr;
+    size_t stride = 0;    // distance in bytes between the start of two rows
+    size_t rowBytes = 0;  // bytes of pixel data in a row (<= stride)
+    unsigned int rows = 0;
+
+    const uint8_t* row(unsigned int y) const { return data + y * stride; }
+    bool isPacked() const { return stride == rowBytes; }
+};
+
+// Read-only view over the planes of a RawImgFrame.
+// Honors Specs::stride and the p1/p2/p3 plane offsets, so aligned or padded frames (e.g. from ImageManip)
+// can be read in place. A zero stride means tightly packed rows.
+class FrameView {
+   public:
+    static constexpr int maxPlanes = 3;
+
+    // Throws std::runtime_error if the frame metadata is invalid or the data is too small for the planes
+    explicit FrameView(const dai::RawImgFrame& frame);
+    explicit FrameView(const std::shared_ptr<dai::ImgFrame>& imgFrame);
+
+    dai::RawImgFrame::Type type() const { return frameType; }
+    unsigned int width() const { return frameWidth; }
+    unsigned int height() const { return frameHeight; }
+
+    int planeCount() const { return numPlanes; }
+    const FramePlane& plane(int index) const { return planes[index]; }
+
+    // True if all planes are packed and directly follow each other, the layout the OpenCV single buffer conversions expect
+    bool isContiguous() const;
+
+    // Mat header over a plane (no copy), cvType gives the element type of the plane's pixels
+    cv::Mat planeMat(int index, int cvType) const;
+
+   private:
+    dai::RawImgFrame::Type frameType;
+    unsigned int frameWidth;
+    unsigned int frameHeight;
+    int numPlanes = 0;
+    FramePlane planes[maxPlanes];
+};
+
+#endif //DEPTHAI_ANDROID_JNI_EXAMPLE_FRAME_VIEW_H
@@ -0,0 +1,41 @@
+#include "host_output_queue.h"
+
+constexpr std::chrono::milliseconds HostOutputQueue::closedPollInterval;
+
+HostOutputQueue::HostOutputQueue(std::shared_ptr<dai::DataOutputQueue> source, unsigned maxSize, bool blocking)
+    : source(std::move(source)) {
+    // The callbacks run on the XLink reading thread, the only producer
+    if(maxSize == 1 && !blocking) {
+        mailbox.reset(new LatestMailbox<std::shared_ptr<dai::ADatatype>>());
+        callbackId = this->source->addCallback([this](std::shared_ptr<dai::ADatatype> msg) { mailbox->push(std::move(msg)); });
+    } else {
+        queue.reset(new SpscQueue<std::shared_ptr<dai::ADatatype>>(maxSize, blocking));
+        callbackId = this->source->addCallback([this](std::shared_ptr<dai::ADatatype> msg) { queue->push(std::move(msg)); });
+    }
+}
+
+HostOutputQueue::~HostOutputQueue() {
+    // Unblock a push waiting in the callback first, removeCallback waits for running callbacks
+    if(queue) queue->destruct();
+    if(mailbox) mailbox->destruct();
+    source->removeCallback(callbackId);
+}
+
+std::string HostOutputQueue::getName() const {
+    return source->getName();
+}
+
+bool HostOutputQueue::tryPop(std::shared_ptr<dai::ADatatype>& val) {
+    return mailbox ? mailbox->tryPop(val) : queue->tryPop(val);
+}
+
+bool HostOutputQueue::waitAndPop(std::shared_ptr<dai::ADatatype>& val, std::chrono::steady_clock::duration timeout) {
+    return mailbox ? mailbox->tryWaitAndPop(val, timeout) : queue->tryWaitAndPop(val, timeout);
+}
+
+void HostOutputQueue::checkOpen() const {
+    bool destructed = mailbox ? mailbox->isDestructed() : queue->isDestructed();
+    if(destructed || source->isClosed()) {
+        throw std::runtime_error("Output queue " + source->getName() + " is closed");
+    }
+}
@@ -0,0 +1,74 @@
+#ifndef DEPTHAI_ANDROID_JNI_EXAMPLE_HOST_OUTPUT_QUEUE_H
+#define DEPTHAI_ANDROID_JNI_EXAMPLE_HOST_OUTPUT_QUEUE_H
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "depthai/depthai.hpp"
+
+#include "latest_mailbox.h"
+#include "spsc_queue.h"
+
+// Output queue read by the app, fed from the DataOutputQueue reading thread through a callback.
+// Messages are handed over through a lock-free SpscQueue instead of the LockingQueue inside
+// DataOutputQueue, which is part of the prebuilt depthai-core library. Open the device queue with
+// maxSize 0 so it doesn't keep a second copy of every message.
+// A maxSize 1 non-blocking queue only ever holds the newest message, it uses a LatestMailbox instead.
+class HostOutputQueue {
+   public:
+    HostOutputQueue(std::shared_ptr<dai::DataOutputQueue> source, unsigned maxSize, bool blocking);
+    HostOutputQueue(const HostOutputQueue&) = delete;
+    HostOutputQueue& operator=(const HostOutputQueue&) = delete;
+    ~HostOutputQueue();
+
+    std::string getName() const;
+
+    // Blocks until a message arrives, throws if the device queue was closed
+    template <class T>
+    std::shared_ptr<T> get() {
+        std::shared_ptr<dai::ADatatype> val;
+        while(!waitAndPop(val, closedPollInterval)) {
+            checkOpen();
+        }
+        return std::dynamic_pointer_cast<T>(val);
+    }
+
+    // Returns nullptr if no message is available or after the timeout
+    template <class T, typename Rep, typename Period>
+    std::shared_ptr<T> get(std::chrono::duration<Rep, Period> timeout, bool& hasTimedout) {
+        std::shared_ptr<dai::ADatatype> val;
+        hasTimedout = !waitAndPop(val, std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout));
+        if(hasTimedout) {
+            checkOpen();
+            return nullptr;
+        }
+        return std::dynamic_pointer_cast<T>(val);
+    }
+
+    template <class T>
+    std::shared_ptr<T> tryGet() {
+        std::shared_ptr<dai::ADatatype> val;
+        if(!tryPop(val)) {
+            checkOpen();
+            return nullptr;
+        }
+        return std::dynamic_pointer_cast<T>(val);
+    }
+
+   private:
+    static constexpr std::chrono::milliseconds closedPollInterval{100};
+
+    bool tryPop(std::shared_ptr<dai::ADatatype>& val);
+    bool waitAndPop(std::shared_ptr<dai::ADatatype>& val, std::chrono::steady_clock::duration timeout);
+    void checkOpen() const;
+
+    std::shared_ptr<dai::DataOutputQueue> source;
+    // Exactly one of them is set
+    std::unique_ptr<SpscQueue<std::shared_ptr<dai::ADatatype>>> queue;
+    std::unique_ptr<LatestMailbox<std::shared_ptr<dai::ADatatype>>> mailbox;
+    dai::DataOutputQueue::CallbackId callbackId;
+};
+
+#endif //DEPTHAI_ANDROID_JNI_EXAMPLE_HOST_OUTPUT_QUEUE_H
@@ -0,0 +1,88 @@
+#ifndef DEPTHAI_ANDROID_JNI_EXAMPLE_LATEST_MAILBOX_H
+#define DEPTHAI_ANDROID_JNI_EXAMPLE_LATEST_MAILBOX_H
+
+#include <atomic>
+#include <chrono>
+
+#include "wait_signal.h"
+
+// Holds only the newest message, for one producer and one consumer (a maxSize 1 non-blocking queue).
+// Triple buffer: the producer writes its back slot and swaps it with the middle one, the consumer
+// swaps the middle slot with its front one when it holds a new message. Both sides are wait-free,
+// the producer never blocks and a message is taken at most once, so the consumer never sees a stale one.
+template <typename T>
+class LatestMailbox {
+   public:
+    LatestMailbox() = default;
+    LatestMailbox(const LatestMailbox&) = delete;
+    LatestMailbox& operator=(const LatestMailbox&) = delete;
+
+    // Wakes up and fails every waiting and later push/pop
+    void destruct() {
+        if(!destructed.exchange(true)) {
+            signalPush.notify();
+        }
+    }
+
+    bool isDestructed() const {
+        return destructed.load();
+    }
+
+    // Producer only, replaces the message if the consumer hasn't taken it yet
+    bool push(T data) {
+        if(destructed) return false;
+        slots[back] = std::move(data);
+        unsigned previous = middle.exchange(back | fresh, std::memory_order_acq_rel);
+        back = previous & indexMask;
+        // Release the replaced message (or the consumer's empty slot) on the producer side
+        slots[back] = T();
+        signalPush.notify();
+        return true;
+    }
+
+    // Consumer only. Returns false if no new message arrived since the last one taken.
+    bool tryPop(T& value) {
+        if(!hasNew()) return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & indexMask;
+        value = std::move(slots[front]);
+        slots[front] = T();
+        return true;
+    }
+
+    bool waitAndPop(T& value) {
+        while(!tryPop(value)) {
+            if(destructed) return false;
+            signalPush.wait([this]() { return hasNew() || destructed; });
+        }
+        return true;
+    }
+
+    template <typename Rep, typename Period>
+    bool tryWaitAndPop(T& value, std::chrono::duration<Rep, Period> timeout) {
+        if(tryPop(value)) return true;
+        if(destructed) return false;
+        signalPush.waitFor([this]() { return hasNew() || destructed; }, timeout);
+        return tryPop(value);
+    }
+
+    bool empty() const {
+        return !hasNew();
+    }
+
+   private:
+    static constexpr unsigned fresh = 4;
+    static constexpr unsigned indexMask = 3;
+
+    bool hasNew() const {
+        return (middle.load(std::memory_order_relaxed) & fresh) != 0;
+    }
+
+    T slots[3];
+    unsigned back = 0;   // producer's slot
+    unsigned front = 2;  // consumer's slot
+    std::atomic<unsigned> middle{1};
+    std::atomic<bool> destructed{false};
+    WaitSignal signalPush;
+};
+
+#endif //DEPTHAI_ANDROID_JNI_EXAMPLE_LATEST_MAILBOX_H
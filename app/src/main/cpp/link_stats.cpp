@@ -0,0 +1,92 @@
+#include "link_stats.h"
+
+namespace {
+
+// Device timestamp of the message, zero if it has none
+std::chrono::steady_clock::time_point messageTimestamp(const std::shared_ptr<dai::ADatatype>& message) {
+    if(auto frame = std::dynamic_pointer_cast<dai::ImgFrame>(message)) return frame->getTimestamp();
+    if(auto detections = std::dynamic_pointer_cast<dai::ImgDetections>(message)) return detections->getTimestamp();
+    return {};
+}
+
+}  // namespace
+
+LinkStats::~LinkStats() {
+    clear();
+}
+
+void LinkStats::addStream(const std::string& name, std::shared_ptr<dai::DataOutputQueue> queue) {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::unique_ptr<Stream> stream(new Stream());
+    stream->name = name;
+    stream->queue = std::move(queue);
+    streams.push_back(std::move(stream));
+}
+
+void LinkStats::clear() {
+    std::lock_guard<std::mutex> lock(mtx);
+    disable();
+    streams.clear();
+}
+
+void LinkStats::setEnabled(bool enable) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if(enable == enabled) return;
+    if(!enable) {
+        disable();
+        return;
+    }
+
+    for(auto& stream : streams) {
+        stream->messages = stream->bytes = stream->timedMessages = stream->totalAgeUs = stream->maxAgeUs = 0;
+        Stream* s = stream.get();
+        stream->callbackId = stream->queue->addCallback([s](std::shared_ptr<dai::ADatatype> message) { s->onMessage(message); });
+    }
+    enabledAt = std::chrono::steady_clock::now();
+    enabled = true;
+}
+
+void LinkStats::disable() {
+    if(!enabled) return;
+    for(auto& stream : streams) {
+        stream->queue->removeCallback(stream->callbackId);
+        stream->callbackId = -1;
+    }
+    enabled = false;
+}
+
+LinkStatsSnapshot LinkStats::snapshot() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    LinkStatsSnapshot result;
+    if(!enabled) return result;
+
+    result.enabled = true;
+    result.elapsed = std::chrono::steady_clock::now() - enabledAt;
+    // The counters are updated by the reading threads while they are copied, so the values of a stream
+    // may be a message apart from each other
+
+    for(const auto& stream : streams) {
+        StreamStats stats;
+        stats.name = stream->name;
+        stats.messages = stream->messages;
+        stats.bytes = stream->bytes;
+        std::uint64_t timed = stream->timedMessages;
+        if(timed > 0) stats.averageAge = std::chrono::microseconds(stream->totalAgeUs / timed);
+        stats.maxAge = std::chrono::microseconds(stream->maxAgeUs);
+        result.streams.push_back(std::move(stats));
+    }
+    return result;
+}
+
+void LinkStats::Stream::onMessage(const std::shared_ptr<dai::ADatatype>& message) {
+    auto now = std::chrono::steady_clock::now();
+    messages.fetch_add(1, std::memory_order_relaxed);
+    bytes.fetch_add(message->getRaw()->data.size(), std::memory_order_relaxed);
+
+    auto timestamp = messageTimestamp(message);
+    if(timestamp.time_since_epoch().count() == 0 || timestamp > now) return;
+    auto age = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - timestamp).count());
+    timedMessages.fetch_add(1, std::memory_order_relaxed);
+    totalAgeUs.fetch_add(age, std::memory_order_relaxed);
+    if(age > maxAgeUs.load(std::memory_order_relaxed)) maxAgeUs.store(age, std::memory_order_relaxed);
+}
@@ -0,0 +1,74 @@
+#ifndef DEPTHAI_ANDROID_JNI_EXAMPLE_LINK_STATS_H
+#define DEPTHAI_ANDROID_JNI_EXAMPLE_LINK_STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "depthai/depthai.hpp"
+
+struct StreamStats {
+    std::string name;
+    std::uint64_t messages = 0;
+    // Payload bytes (frame data, serialized detections are metadata and count as 0)
+    std::uint64_t bytes = 0;
+    // Message age: from the device timestamp (capture, converted to the host clock by depthai) to the
+    // queue callback on the host, for messages that carry one. This covers device processing, the link
+    // and parsing together, and is only as accurate as depthai's device clock sync. It isn't XLink read latency.
+    std::chrono::microseconds averageAge{0};
+    std::chrono::microseconds maxAge{0};
+};
+
+struct LinkStatsSnapshot {
+    bool enabled = false;
+    // Since the stats were enabled
+    std::chrono::duration<double> elapsed{0};
+    std::vector<StreamStats> streams;
+};
+
+// Callback level statistics of the device's output streams: message counts, payload bytes (throughput)
+// and message age, taken from the output queue callbacks. Only public depthai API is used, XLink's
+// profiling counters and fill levels aren't reachable through the prebuilt core.
+// While disabled the callbacks aren't installed, so reading costs nothing extra.
+class LinkStats {
+   public:
+    ~LinkStats();
+
+    // Streams are watched from the next enable(true) on
+    void addStream(const std::string& name, std::shared_ptr<dai::DataOutputQueue> queue);
+    // Disables and forgets the streams, e.g. before the device is replaced
+    void clear();
+
+    // Enabling resets all counters
+    void setEnabled(bool enabled);
+
+    LinkStatsSnapshot snapshot() const;
+
+   private:
+    struct Stream {
+        std::string name;
+        std::shared_ptr<dai::DataOutputQueue> queue;
+        int callbackId = -1;
+        // Written by the queue's reading thread only
+        std::atomic<std::uint64_t> messages{0};
+        std::atomic<std::uint64_t> bytes{0};
+        std::atomic<std::uint64_t> timedMessages{0};
+        std::atomic<std::uint64_t> totalAgeUs{0};
+        std::atomic<std::uint64_t> maxAgeUs{0};
+
+        void onMessage(const std::shared_ptr<dai::ADatatype>& message);
+    };
+
+    void disable();
+
+    mutable std::mutex mtx;
+    std::vector<std::unique_ptr<Stream>> streams;
+    bool enabled = false;
+    std::chrono::steady_clock::time_point enabledAt;
+};
+
+#endif //DEPTHAI_ANDROID_JNI_EXAMPLE_LINK_STATS_H
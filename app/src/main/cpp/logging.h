@@ -0,0 +1,17 @@
+#ifndef DEPTHAI_ANDROID_JNI_EXAMPLE_LOGGING_H
+#define DEPTHAI_ANDROID_JNI_EXAMPLE_LOGGING_H
+
+// printf style logging: logcat on Android, stderr where the sources are built for the host tests.
+// Include it after <cmath> (or headers pulling it in), the macro shadows std::log.
+#if defined(__ANDROID__)
+    #include <android/log.h>
+
+    #define LOG_TAG "depthaiAndroid"
+    #define log(...) __android_log_print(ANDROID_LOG_INFO,LOG_TAG, __VA_ARGS__)
+#else
+    #include <cstdio>
+
+    #define log(...) (std::fprintf(stderr, __VA_ARGS__), std::fputc('\n', stderr))
+#endif
+
+#endif //DEPTHAI_ANDROID_JNI_EXAMPLE_LOGGING_H
@@ -0,0 +1,137 @@
+#include <algorithm>
+
+#include "message_synchronizer.h"
+
+namespace {
+
+// Sequence number and timestamp of the message types that carry them
+template <class T>
+bool readKeys(const std::shared_ptr<dai::ADatatype>& msg, int64_t& sequenceNum, std::chrono::steady_clock::time_point& timestamp) {
+    auto typed = std::dynamic_pointer_cast<T>(msg);
+    if(!typed) return false;
+    sequenceNum = typed->getSequenceNum();
+    timestamp = typed->getTimestamp();
+    return true;
+}
+
+bool readKeys(const std::shared_ptr<dai::ADatatype>& msg, int64_t& sequenceNum, std::chrono::steady_clock::time_point& timestamp) {
+    return readKeys<dai::ImgFrame>(msg, sequenceNum, timestamp) || readKeys<dai::ImgDetections>(msg, sequenceNum, timestamp)
+           || readKeys<dai::SpatialImgDetections>(msg, sequenceNum, timestamp) || readKeys<dai::NNData>(msg, sequenceNum, timestamp);
+}
+
+}  // namespace
+
+MessageSynchronizer::MessageSynchronizer(std::chrono::microseconds tolerance, size_t maxBuffered, Callback callback)
+    : tolerance(tolerance), maxBuffered(std::max<size_t>(maxBuffered, 1)), callback(std::move(callback)) {}
+
+MessageSynchronizer::~MessageSynchronizer() {
+    // Not under the lock, a running queue callback holds the queue's callback mutex and waits for ours
+    std::vector<Stream> removed;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        removed.swap(streams);
+    }
+    for(auto& stream : removed) {
+        stream.queue->removeCallback(stream.callbackId);
+    }
+}
+
+int MessageSynchronizer::addStream(std::shared_ptr<dai::DataOutputQueue> queue, SyncKey key) {
+    int index;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        index = static_cast<int>(streams.size());
+        streams.push_back({key, queue, 0, {}});
+        matches.resize(streams.size());
+    }
+
+    auto id = queue->addCallback([this, index](std::shared_ptr<dai::ADatatype> msg) { push(index, std::move(msg)); });
+
+    std::lock_guard<std::mutex> lock(mtx);
+    streams[index].callbackId = id;
+    return index;
+}
+
+uint64_t MessageSynchronizer::getDroppedCount() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return dropped;
+}
+
+void MessageSynchronizer::push(int stream, std::shared_ptr<dai::ADatatype> msg) {
+    Entry entry{std::move(msg), 0, {}};
+    std::lock_guard<std::mutex> lock(mtx);
+    if(stream >= static_cast<int>(streams.size()) || !readKeys(entry.msg, entry.sequenceNum, entry.timestamp)) {
+        dropped++;
+        return;
+    }
+
+    auto& buffer = streams[stream].buffer;
+    if(buffer.size() >= maxBuffered) {
+        buffer.pop_front();
+        dropped++;
+    }
+    buffer.push_back(std::move(entry));
+    emitGroups();
+}
+
+// Messages of a stream arrive in order, so once a later message is buffered an earlier match can't come anymore
+MessageSynchronizer::Match MessageSynchronizer::find(const Stream& stream, const Entry& reference, size_t& index) const {
+    const auto& buffer = stream.buffer;
+    if(stream.key == SyncKey::SEQUENCE_NUM) {
+        for(size_t i = 0; i < buffer.size(); i++) {
+            if(buffer[i].sequenceNum == reference.sequenceNum) {
+                index = i;
+                return Match::FOUND;
+            }
+            if(buffer[i].sequenceNum > reference.sequenceNum) return Match::NEVER;
+        }
+        return Match::PENDING;
+    }
+
+    // Closest timestamp within the tolerance
+    bool found = false;
+    auto best = tolerance;
+    for(size_t i = 0; i < buffer.size(); i++) {
+        auto distance = std::chrono::duration_cast<std::chrono::microseconds>(buffer[i].timestamp - reference.timestamp);
+        if(distance > tolerance) break;
+        if(distance < -tolerance) continue;
+        if(distance < distance.zero()) distance = -distance;
+        if(distance <= best) {
+            best = distance;
+            index = i;
+            found = true;
+        }
+    }
+    if(found) return Match::FOUND;
+    if(!buffer.empty() && buffer.back().timestamp > reference.timestamp + tolerance) return Match::NEVER;
+    return Match::PENDING;
+}
+
+void MessageSynchronizer::emitGroups() {
+    auto& reference = streams[0].buffer;
+
+    while(!reference.empty()) {
+        Match result = Match::FOUND;
+        for(size_t s = 1; s < streams.size() && result == Match::FOUND; s++) {
+            result = find(streams[s], reference.front(), matches[s]);
+        }
+        if(result == Match::PENDING) return;
+        if(result == Match::NEVER) {
+            reference.pop_front();
+            dropped++;
+            continue;
+        }
+
+        // Older messages of the other streams can't be part of a later group
+        MessageGroup group(streams.size());
+        group[0] = std::move(reference.front().msg);
+        reference.pop_front();
+        for(size_t s = 1; s < streams.size(); s++) {
+            auto& buffer = streams[s].buffer;
+            group[s] = std::move(buffer[matches[s]].msg);
+            dropped += matches[s];
+            buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(matches[s]) + 1);
+        }
+        callback(std::move(group));
+    }
+}
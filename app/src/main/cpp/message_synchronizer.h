@@ -0,0 +1,76 @@
+#ifndef DEPTHAI_ANDROID_JNI_EXAMPLE_MESSAGE_SYNCHRONIZER_H
+#define DEPTHAI_ANDROID_JNI_EXAMPLE_MESSAGE_SYNCHRONIZER_H
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "depthai/depthai.hpp"
+
+// How a stream is matched against the reference stream
+enum class SyncKey {
+    SEQUENCE_NUM,  // same sequence number, e.g. a NN passthrough frame and its detections
+    TIMESTAMP      // closest timestamp within the tolerance, e.g. frames of different cameras
+};
+
+// One message per stream, in the order the streams were added
+using MessageGroup = std::vector<std::shared_ptr<dai::ADatatype>>;
+
+// Groups the messages of several output queues that belong together and emits only complete groups.
+// The first stream is the reference, every other stream is matched against its messages by sequence
+// number or timestamp. Each stream buffers at most maxBuffered messages, the oldest one is dropped
+// when it is full, and reference messages that can no longer be matched are dropped too.
+// Works with ImgFrame, ImgDetections, SpatialImgDetections and NNData messages.
+class MessageSynchronizer {
+   public:
+    // Called with each complete group, on the reading thread of the queue that completed it.
+    // It runs under the synchronizer lock, so it should only hand the group over (move it).
+    using Callback = std::function<void(MessageGroup&&)>;
+
+    MessageSynchronizer(std::chrono::microseconds tolerance, size_t maxBuffered, Callback callback);
+    MessageSynchronizer(const MessageSynchronizer&) = delete;
+    MessageSynchronizer& operator=(const MessageSynchronizer&) = delete;
+    ~MessageSynchronizer();
+
+    // Feeds the stream from the queue's callback, returns the index of the stream in the groups
+    int addStream(std::shared_ptr<dai::DataOutputQueue> queue, SyncKey key);
+
+    // Messages that were dropped without being part of a group
+    uint64_t getDroppedCount() const;
+
+   private:
+    struct Entry {
+        std::shared_ptr<dai::ADatatype> msg;
+        int64_t sequenceNum;
+        std::chrono::steady_clock::time_point timestamp;
+    };
+
+    struct Stream {
+        SyncKey key;
+        std::shared_ptr<dai::DataOutputQueue> queue;
+        dai::DataOutputQueue::CallbackId callbackId;
+        std::deque<Entry> buffer;
+    };
+
+    enum class Match { FOUND, PENDING, NEVER };
+
+    void push(int stream, std::shared_ptr<dai::ADatatype> msg);
+    Match find(const Stream& stream, const Entry& reference, size_t& index) const;
+    void emitGroups();
+
+    const std::chrono::microseconds tolerance;
+    const size_t maxBuffered;
+    const Callback callback;
+
+    mutable std::mutex mtx;
+    std::vector<Stream> streams;
+    // Scratch space of emitGroups
+    std::vector<size_t> matches;
+    uint64_t dropped = 0;
+};
+
+#endif //DEPTHAI_ANDROID_JNI_EXAMPLE_MESSAGE_SYNCHRONIZER_H
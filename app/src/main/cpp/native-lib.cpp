@@ -1,48 +1,210 @@
+#include <algorithm>
 #include <chrono>
+#include <cstring>
+#include <future>
 #include <string>
+#include <thread>
+#include <tuple>
 #include <jni.h>
+#include <sys/resource.h>
 
 #include <libusb/libusb.h>
 #include "opencv2/core.hpp"
 #include "depthai/depthai.hpp"
 
 #include "utils.h"
+#include "frame_pool.h"
+#include "pixel_pack.h"
+#include "disparity_colorizer.h"
+#include "frame_converter.h"
+#include "frame_view.h"
+#include "host_output_queue.h"
+#include "latest_mailbox.h"
+#include "message_synchronizer.h"
+#include "chunk_size_tuner.h"
+#include "link_stats.h"
+#include "reader_thread_policy.h"
+#include "blob_source.h"
+#include "startup_timeline.h"
+#include "trace.h"
+#include "device_capabilities.h"
 
 using namespace std;
 
 std::shared_ptr<dai::Device> device;
-shared_ptr<dai::DataOutputQueue> qRgb, qDepth, qDet;
-cv::Mat detection_img;
+// Queried once per connect, read by the per frame calls instead of RPCs to the device
+DeviceCapabilities deviceCapabilities;
+// Read through lock-free host queues, the device queues (maxSize 0) only forward to their callbacks
+shared_ptr<HostOutputQueue> qRgb, qDepth, qDet, qRawDepth;
+
+// With syncNN, rgb, detections and depth are read as aligned groups instead of from qRgb, qDet and qDepth.
+// imageFromJNI takes the newest group, detectionImageFromJNI and depthFromJNI use the rest of it.
+unique_ptr<MessageSynchronizer> synchronizer;
+LatestMailbox<MessageGroup> syncedGroups;
+static int syncRgb = -1, syncDet = -1, syncDepth = -1;
+std::shared_ptr<dai::ImgDetections> syncedDetections;
+std::shared_ptr<dai::ImgFrame> syncedDepth;
+// Depth frames come from the mono cameras, they are paired with the closest rgb frame within this
+static const std::chrono::milliseconds syncTolerance{20};
+static const size_t syncMaxBuffered = 8;
+static const std::chrono::seconds syncTimeout{1};
+// Converts rgb frames straight into the frame buffers
+FrameConverter frameConverter;
+static int previewWidth = 0, previewHeight = 0;
+
+// Frame buffers shared with Java, one pool per displayed stream
+static const int framePoolSlots = 3;
+std::unique_ptr<FramePool> framePools[FRAME_STREAM_COUNT];
 
 // Neural network
-std::vector<uint8_t> model_buffer;
 static std::atomic<bool> syncNN{true};
-std::vector<dai::ImgDetection> detections;
 
 // Closer-in minimum depth, disparity range is doubled (from 95 to 190):
 static std::atomic<bool> extended_disparity{true};
 auto maxDisparity = extended_disparity ? 190.0f :95.0f;
 
+// Colormap of the disparity image, the lookup table is rebuilt only when it or maxDisparity change
+static std::atomic<int> disparityColormap{static_cast<int>(Colormap::RAINBOW)};
+DisparityColorizer disparityColorizer;
+
 // Better accuracy for longer distance, fractional disparity 32-levels:
 static std::atomic<bool> subpixel{false};
 // Better handling for occlusions:
 static std::atomic<bool> lr_check{false};
+// Also stream the RAW16 depth (millimeters) for rawDepthFromJNI:
+static std::atomic<bool> raw_depth{false};
+
+// Measure the XLink chunk size at startup instead of using the default (takes a second or two and
+// a second device boot, on the first start with a device only as the result is cached):
+static std::atomic<bool> tune_chunk_size{false};
+ChunkSizeTuner chunkSizeTuner;
+static const std::chrono::seconds rebootTimeout{10};
+
+// Run the XLink reading threads on the big cores with a raised priority, against scheduling jitter:
+static std::atomic<bool> reader_fast_cores{false};
+std::unique_ptr<ReaderThreadPolicy> readerThreadPolicy;
+
+// Link utilization of the device's output streams, off unless enabled from Java
+LinkStats linkStats;
+
+// Disparity output size for THE_400_P mono cameras
+static const int disparityWidth = 640;
+static const int disparityHeight = 400;
+
+// Phases of the last startDevice, up to the first rgb frame
+StartupTimeline startupTimeline;
+
+// Reads and parses the model blob on a worker thread, so it overlaps the device boot
+static std::future<dai::OpenVINO::Blob> loadModelAsync(AAssetManager* assetManager, std::string path) {
+    return std::async(std::launch::async, [assetManager, path]() {
+        trace::setThreadName("model loader");
+        trace::Span span("model load");
+        startupTimeline.begin(STARTUP_MODEL_LOAD);
+        // Mapped from the APK and copied once into the Blob (moved into the pipeline from there)
+        BlobSource source = BlobSource::fromAsset(assetManager, path.c_str());
+        auto blob = source.toBlob();
+        log("Model blob %zu bytes (%s)", source.size(), source.isMapped() ? "mapped" : "buffered");
+        startupTimeline.end(STARTUP_MODEL_LOAD);
+        return blob;
+    });
+}
 
-extern "C"
-JNIEXPORT void JNICALL
-Java_com_example_depthai_1android_1jni_1example_MainActivity_startDevice(JNIEnv *env, jobject thiz, jstring model_path,
-                        int rgbWidth, int rgbHeight) {
+// After close() the device reboots and is listed again once it is back in its unbooted state
+static bool findDevice(const std::string& mxId, dai::DeviceInfo& deviceInfo, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    do {
+        bool found = false;
+        std::tie(found, deviceInfo) = dai::Device::getDeviceByMxId(mxId);
+        if(found && deviceInfo.state != X_LINK_BOOTED) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    } while(std::chrono::steady_clock::now() < deadline);
+    return false;
+}
+
+// Throws if the device can't be found or started, the JNI entry point hands that to Java
+static void startDevice(JNIEnv *env, jobject thiz, jstring model_path, int rgbWidth, int rgbHeight) {
 
     // libusb
     auto r = libusb_set_option(nullptr, LIBUSB_OPTION_ANDROID_JNIENV, env);
     log("libusb_set_option ANDROID_JAVAVM: %s", libusb_strerror(r));
+    log("Pixel pack kernel: %s", packKernelName());
 
-    // Connect to device and start pipeline
-    device = make_shared<dai::Device>(dai::OpenVINO::VERSION_2021_4, dai::UsbSpeed::HIGH);
+    startupTimeline.reset();
+    trace::Span startSpan("startDevice");
+    const char * path = env->GetStringUTFChars(model_path, 0);
+    auto model_blob = loadModelAsync(BlobSource::assetManagerOf(env, thiz), path);
+    env->ReleaseStringUTFChars(model_path, path);
 
-    bool oakD = device->getConnectedCameras().size() == 3;
+    // Connect to device and start pipeline, on this thread as libusb was given its JNIEnv
+    linkStats.clear();
+    readerThreadPolicy.reset();
+
+    // Nothing of the previous pipeline may be read after a restart.
+    // The queues of the previous device are released before it is closed.
+    if(synchronizer) {
+        log("Synchronizer dropped %llu messages", static_cast<unsigned long long>(synchronizer->getDroppedCount()));
+    }
+    synchronizer.reset();
+    MessageGroup staleGroup;
+    syncedGroups.tryPop(staleGroup);
+    syncedDetections.reset();
+    syncedDepth.reset();
+    qRgb.reset();
+    qDet.reset();
+    qDepth.reset();
+    qRawDepth.reset();
+
+    startupTimeline.begin(STARTUP_DEVICE_BOOT);
+    bool found = false;
+    dai::DeviceInfo deviceInfo;
+    {
+        trace::Span span("device search");
+        std::tie(found, deviceInfo) = dai::Device::getAnyAvailableDevice();
+    }
+    if(!found) throw std::runtime_error("No available devices");
+    {
+        trace::Span span("device boot and connect");
+        device = make_shared<dai::Device>(dai::OpenVINO::VERSION_2021_4, deviceInfo, dai::UsbSpeed::HIGH);
+    }
+    startupTimeline.end(STARTUP_DEVICE_BOOT);
+
+    {
+        trace::Span span("device capabilities");
+        deviceCapabilities = DeviceCapabilities::query(*device);
+    }
+    log("Device %s, %zu cameras, usb speed %d, calibrated: %d", deviceCapabilities.mxId.c_str(), deviceCapabilities.connectedCameras.size(),
+        static_cast<int>(deviceCapabilities.usbSpeed), deviceCapabilities.calibrated);
+    bool oakD = deviceCapabilities.hasStereo();
+
+    // The chunk size measured on an earlier start with this device and link is reused, without probing
+    int chunkSize = -1;
+    if(tune_chunk_size) {
+        std::string cacheDirectory = getCacheDirectory(env, thiz);
+        if(!cacheDirectory.empty()) chunkSize = chunkSizeTuner.loadCached(cacheDirectory, deviceCapabilities.mxId, deviceCapabilities.usbSpeed);
+        if(chunkSize >= 0) {
+            log("XLink chunk size %d (cached)", chunkSize);
+        } else {
+            // Measured on the idle link with the probe pipeline, then the device is booted again for ours
+            trace::Span span("chunk size probe");
+            chunkSize = chunkSizeTuner.tune(*device);
+            for(const auto& measurement : chunkSizeTuner.getMeasurements()) {
+                log("XLink chunk size %d: %.1f MB/s, round trip %lld us", measurement.chunkSize, measurement.bytesPerSecond / 1e6,
+                    static_cast<long long>(measurement.roundTrip.count()));
+            }
+            if(!cacheDirectory.empty()) chunkSizeTuner.storeCached(cacheDirectory, deviceCapabilities.mxId, deviceCapabilities.usbSpeed);
+
+            device->close();
+            device.reset();
+            if(!findDevice(deviceCapabilities.mxId, deviceInfo, rebootTimeout)) {
+                throw std::runtime_error("Device didn't come back after the chunk size probe");
+            }
+            device = make_shared<dai::Device>(dai::OpenVINO::VERSION_2021_4, deviceInfo, dai::UsbSpeed::HIGH);
+        }
+    }
 
     // Create pipeline
+    startupTimeline.begin(STARTUP_PIPELINE_BUILD);
+    auto buildBegin = dai::Clock::now();
     dai::Pipeline pipeline;
 
     // Define source and output
@@ -62,13 +224,6 @@ Java_com_example_depthai_1android_1jni_1example_MainActivity_startDevice(JNIEnv
     auto nnOut = pipeline.create<dai::node::XLinkOut>();
     nnOut->setStreamName("detections");
 
-    // Load model blob
-    std::vector<uint8_t> model_buf;
-    const char * path = env->GetStringUTFChars(model_path, 0);
-    readModelFromAsset(path, model_buffer, env, thiz);
-    env->ReleaseStringUTFChars(model_path, path);
-    auto model_blob = dai::OpenVINO::Blob(model_buffer);
-
     // Network specific settings
     detectionNetwork->setConfidenceThreshold(0.5f);
     detectionNetwork->setNumClasses(80);
@@ -80,7 +235,8 @@ Java_com_example_depthai_1android_1jni_1example_MainActivity_startDevice(JNIEnv
     detectionNetwork->setAnchors({10,13, 16,30, 33,23, 30,61, 62,45, 59,119, 116,90, 156,198, 373,326});
     detectionNetwork->setAnchorMasks({{"side52", {0, 1, 2}}, {"side26", {3, 4, 5}}, {"side13", {6, 7, 8}}});
     detectionNetwork->setIouThreshold(0.5f);
-    detectionNetwork->setBlob(model_blob);
+    // Joins the model load. get() returns the Blob by value, so its data is moved into setBlob, not copied
+    detectionNetwork->setBlob(model_blob.get());
     detectionNetwork->setNumInferenceThreads(2);
     detectionNetwork->input.setBlocking(false);
 
@@ -113,96 +269,391 @@ Java_com_example_depthai_1android_1jni_1example_MainActivity_startDevice(JNIEnv
         stereo->setExtendedDisparity(extended_disparity);
         stereo->setSubpixel(subpixel);
 
+        // In disparity output units (RAW16 with fractional bits in subpixel mode)
+        maxDisparity = stereo->initialConfig.getMaxDisparity();
+        disparityColorizer.configure(maxDisparity, static_cast<Colormap>(disparityColormap.load()));
+
         // Linking
         monoLeft->out.link(stereo->left);
         monoRight->out.link(stereo->right);
         stereo->disparity.link(xoutDepth->input);
+
+        if(raw_depth) {
+            auto xoutRawDepth = pipeline.create<dai::node::XLinkOut>();
+            xoutRawDepth->setStreamName("rawDepth");
+            stereo->depth.link(xoutRawDepth->input);
+        }
     }
 
-    device->startPipeline(pipeline);
+    if(chunkSize >= 0) {
+        pipeline.setXLinkChunkSize(chunkSize);
+        log("XLink chunk size set to %d", chunkSize);
+    }
 
-    // Output queue will be used to get the rgb frames from the output defined above
-    qRgb = device->getOutputQueue("rgb", 1, false);
-    detection_img = cv::Mat(rgbHeight, rgbWidth, CV_8UC3);
+    startupTimeline.end(STARTUP_PIPELINE_BUILD);
+    trace::complete("pipeline build", buildBegin);
 
+    startupTimeline.begin(STARTUP_PIPELINE_START);
+    {
+        trace::Span span("startPipeline");
+        device->startPipeline(pipeline);
+    }
+    startupTimeline.end(STARTUP_PIPELINE_START);
 
-    // Output queue will be used to get the nn output from the neural network node defined above
-    qDet = device->getOutputQueue("detections", 1, false);
+    previewWidth = rgbWidth;
+    previewHeight = rgbHeight;
+    // RAW16 frames on the rgb stream are colored like the disparity
+    frameConverter.setDisparityColorizer(&disparityColorizer);
 
-    if(oakD) {
+    auto queuesBegin = dai::Clock::now();
+    if(syncNN) {
+        // Detections carry the sequence number of their passthrough frame
+        synchronizer.reset(new MessageSynchronizer(syncTolerance, syncMaxBuffered, [](MessageGroup&& group) { syncedGroups.push(std::move(group)); }));
+        syncRgb = synchronizer->addStream(device->getOutputQueue("rgb", 0, false), SyncKey::SEQUENCE_NUM);
+        syncDet = synchronizer->addStream(device->getOutputQueue("detections", 0, false), SyncKey::SEQUENCE_NUM);
+        syncDepth = oakD ? synchronizer->addStream(device->getOutputQueue("depth", 0, false), SyncKey::TIMESTAMP) : -1;
+    } else {
         // Output queue will be used to get the rgb frames from the output defined above
-        qDepth = device->getOutputQueue("depth", 1, false);
+        qRgb = make_shared<HostOutputQueue>(device->getOutputQueue("rgb", 0, false), 1, false);
+
+        // Output queue will be used to get the nn output from the neural network node defined above
+        qDet = make_shared<HostOutputQueue>(device->getOutputQueue("detections", 0, false), 1, false);
+
+        if(oakD) {
+            // Output queue will be used to get the rgb frames from the output defined above
+            qDepth = make_shared<HostOutputQueue>(device->getOutputQueue("depth", 0, false), 1, false);
+        }
+    }
+
+    if(oakD && raw_depth) {
+        // Output queue will be used to get the depth in millimeters
+        qRawDepth = make_shared<HostOutputQueue>(device->getOutputQueue("rawDepth", 0, false), 1, false);
+    }
+    trace::complete("queue setup", queuesBegin);
+
+    if(reader_fast_cores) readerThreadPolicy.reset(new ReaderThreadPolicy(ThreadPolicy::fastCores()));
+    for(const auto& name : device->getOutputQueueNames()) {
+        linkStats.addStream(name, device->getOutputQueue(name));
+        if(readerThreadPolicy) readerThreadPolicy->attach(device->getOutputQueue(name));
+        if(trace::isEnabled()) {
+            // Marks the first message of each stream, the flag keeps later messages to one load
+            auto seen = std::make_shared<std::atomic<bool>>(false);
+            std::string event = "first message " + name;
+            device->getOutputQueue(name)->addCallback([seen, event](std::shared_ptr<dai::ADatatype>) {
+                if(!seen->load(std::memory_order_relaxed) && !seen->exchange(true)) trace::instant(event.c_str());
+            });
+        }
+    }
+
+    // Frame buffers handed to Java, RGBA (4 bytes per pixel) like the ARGB_8888 Bitmaps
+    for(auto& pool : framePools) {
+        if(pool) pool->destroy(env);
+    }
+    framePools[FRAME_STREAM_RGB].reset(new FramePool(env, framePoolSlots, rgbWidth * rgbHeight * 4));
+    if(oakD) {
+        framePools[FRAME_STREAM_DEPTH].reset(new FramePool(env, framePoolSlots, disparityWidth * disparityHeight * 4));
+    } else {
+        framePools[FRAME_STREAM_DEPTH].reset();
+    }
+    // Raw depth buffers hold one uint16_t (millimeters) per pixel
+    if(oakD && raw_depth) {
+        framePools[FRAME_STREAM_RAW_DEPTH].reset(new FramePool(env, framePoolSlots, disparityWidth * disparityHeight * 2));
+    } else {
+        framePools[FRAME_STREAM_RAW_DEPTH].reset();
+    }
+}
+
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_example_depthai_1android_1jni_1example_MainActivity_startDevice(JNIEnv *env, jobject thiz, jstring model_path,
+                        int rgbWidth, int rgbHeight) {
+
+    // A C++ exception must not unwind through the JVM, Java gets a RuntimeException instead
+    try {
+        startDevice(env, thiz, model_path, rgbWidth, rgbHeight);
+    } catch(const std::exception& e) {
+        log("startDevice: %s", e.what());
+        env->ThrowNew(env->FindClass("java/lang/RuntimeException"), e.what());
     }
+}
+
+extern "C"
+JNIEXPORT jobjectArray JNICALL
+Java_com_example_depthai_1android_1jni_1example_MainActivity_getFrameBuffers(JNIEnv *env, jobject thiz, jint stream) {
 
+    if(stream < 0 || stream >= FRAME_STREAM_COUNT || !framePools[stream]) return nullptr;
+    return framePools[stream]->buffers(env);
 }
 
-extern "C" JNIEXPORT jintArray JNICALL
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_example_depthai_1android_1jni_1example_MainActivity_releaseFrame(JNIEnv *env, jobject thiz, jint stream, jint slot) {
+
+    if(stream < 0 || stream >= FRAME_STREAM_COUNT || !framePools[stream]) return;
+    framePools[stream]->release(slot);
+}
+
+extern "C" JNIEXPORT jint JNICALL
 Java_com_example_depthai_1android_1jni_1example_MainActivity_imageFromJNI(
         JNIEnv* env,
         jobject /* this */) {
 
     std::shared_ptr<dai::ImgFrame> inRgb;
-    if(syncNN) {
-        inRgb = qRgb->get<dai::ImgFrame>();
+    if(synchronizer) {
+        // One wait for the whole group instead of one per stream
+        MessageGroup group;
+        if(!syncedGroups.tryWaitAndPop(group, syncTimeout)) return -1;
+        inRgb = std::dynamic_pointer_cast<dai::ImgFrame>(group[syncRgb]);
+        syncedDetections = std::dynamic_pointer_cast<dai::ImgDetections>(group[syncDet]);
+        if(syncDepth >= 0) syncedDepth = std::dynamic_pointer_cast<dai::ImgFrame>(group[syncDepth]);
     } else {
-        inRgb = qRgb->tryGet<dai::ImgFrame>();
+        // Throws once the device queue is closed, e.g. after unplugging
+        try {
+            inRgb = qRgb->tryGet<dai::ImgFrame>();
+        } catch(const std::exception& e) {
+            log("imageFromJNI: %s", e.what());
+            return -1;
+        }
     }
 
-    if(!inRgb) return nullptr;
+    if(!inRgb) return -1;
+    if(static_cast<int>(inRgb->getWidth()) != previewWidth || static_cast<int>(inRgb->getHeight()) != previewHeight) return -1;
+
+    auto& pool = framePools[FRAME_STREAM_RGB];
+    int slot = pool->acquire();
+    if(slot < 0) return -1;
+
+    // Write the image straight into the frame buffer shared with the Bitmap.
+    // Frames that can't be converted are dropped, exceptions must not leave a JNI function.
+    try {
+        frameConverter.convertToRgba(inRgb, pool->data(slot));
+    } catch(const std::exception& e) {
+        pool->release(slot);
+        log("imageFromJNI: %s", e.what());
+        return -1;
+    }
+    pool->publish(slot);
+
+    if(!startupTimeline.isEnded(STARTUP_FIRST_FRAME)) {
+        startupTimeline.end(STARTUP_FIRST_FRAME);
+        trace::instant("first frame");
+        startupTimeline.report();
+        struct rusage usage {};
+        getrusage(RUSAGE_SELF, &usage);
+        log("Peak RSS %ld kB", usage.ru_maxrss);
+    }
+    return slot;
+}
 
-    // Copy image data to cv img
-    detection_img = imgframeToCvMat(inRgb);
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_example_depthai_1android_1jni_1example_MainActivity_setDisparityColormap(JNIEnv *env, jobject thiz, jint colormap) {
 
-    // Copy image data to Bitmap int array
-    return cvMatToBmpArray(env, detection_img);
+    if(colormap < static_cast<int>(Colormap::RAINBOW) || colormap > static_cast<int>(Colormap::GRAY)) return;
+    disparityColormap = colormap;
 }
 
-extern "C" JNIEXPORT jintArray JNICALL
+extern "C" JNIEXPORT jint JNICALL
 Java_com_example_depthai_1android_1jni_1example_MainActivity_depthFromJNI(
         JNIEnv* env,
         jobject /* this */) {
 
-    bool oakD = device->getConnectedCameras().size() == 3;
-    if(!oakD){
-        return env->NewIntArray(0);
+    // A frame with invalid metadata (FrameView) is dropped, exceptions must not leave a JNI function
+    try {
+        if(!deviceCapabilities.hasStereo()){
+            return -1;
+        }
+
+        // Depth of the current synced group, each frame is shown once
+        std::shared_ptr<dai::ImgFrame> inDepth;
+        if(synchronizer) {
+            inDepth = std::move(syncedDepth);
+        } else {
+            inDepth = qDepth->tryGet<dai::ImgFrame>();
+        }
+        if(!inDepth) return -1;
+
+        FrameView view(inDepth);
+        const FramePlane& plane = view.plane(0);
+
+        auto& pool = framePools[FRAME_STREAM_DEPTH];
+        size_t width = view.width();
+        if(width * view.height() > pool->slotBytes() / 4) return -1;
+
+        int slot = pool->acquire();
+        if(slot < 0) return -1;
+        uint8_t* result = pool->data(slot);
+
+        // Convert the disparity to color row by row (rows may be padded),
+        // RAW8 in standard/extended mode and RAW16 in subpixel mode
+        disparityColorizer.configure(maxDisparity, static_cast<Colormap>(disparityColormap.load()));
+        switch(view.type()) {
+            case dai::RawImgFrame::Type::RAW8:
+                for(unsigned int y = 0; y < plane.rows; y++) {
+                    disparityColorizer.colorize(plane.row(y), result + y * width * 4, width);
+                }
+                pool->publish(slot);
+                return slot;
+
+            case dai::RawImgFrame::Type::RAW16:
+                for(unsigned int y = 0; y < plane.rows; y++) {
+                    disparityColorizer.colorize(reinterpret_cast<const uint16_t*>(plane.row(y)), result + y * width * 4, width);
+                }
+                pool->publish(slot);
+                return slot;
+
+            default:
+                log("Unsupported disparity frame type: %d", static_cast<int>(inDepth->getType()));
+                break;
+        }
+
+        pool->release(slot);
+        return -1;
+    } catch(const std::exception& e) {
+        log("depthFromJNI: %s", e.what());
+        return -1;
     }
+}
 
-    auto inDepth =  qDepth->get<dai::ImgFrame>();;
-    auto imgData = inDepth->getData();
-
-    u_long image_size = imgData.size();
-    jintArray result = env->NewIntArray(image_size);
-    jint* result_e = env->GetIntArrayElements(result, NULL);
+extern "C" JNIEXPORT jint JNICALL
+Java_com_example_depthai_1android_1jni_1example_MainActivity_rawDepthFromJNI(
+        JNIEnv* env,
+        jobject /* this */) {
 
-    for (int i = 0; i < image_size; i++)
-    {
-        // Convert the disparity to color
-        result_e[i] = colorDisparity(imgData[i], maxDisparity);
+    // A frame with invalid metadata (FrameView) is dropped, exceptions must not leave a JNI function
+    try {
+        auto& pool = framePools[FRAME_STREAM_RAW_DEPTH];
+        if(!pool || !qRawDepth) return -1;
+
+        auto inDepth = qRawDepth->tryGet<dai::ImgFrame>();
+        if(!inDepth || inDepth->getType() != dai::RawImgFrame::Type::RAW16) return -1;
+
+        // Depth in millimeters, 0 for invalid pixels, copied without the row padding
+        FrameView view(inDepth);
+        const FramePlane& plane = view.plane(0);
+        if(plane.rowBytes * plane.rows > pool->slotBytes()) return -1;
+
+        int slot = pool->acquire();
+        if(slot < 0) return -1;
+
+        uint8_t* result = pool->data(slot);
+        if(plane.isPacked()) {
+            std::memcpy(result, plane.data, plane.rowBytes * plane.rows);
+        } else {
+            for(unsigned int y = 0; y < plane.rows; y++) {
+                std::memcpy(result + y * plane.rowBytes, plane.row(y), plane.rowBytes);
+            }
+        }
+        pool->publish(slot);
+        return slot;
+    } catch(const std::exception& e) {
+        log("rawDepthFromJNI: %s", e.what());
+        return -1;
     }
-
-    env->ReleaseIntArrayElements(result, result_e, NULL);
-    return result;
 }
 
 
 extern "C"
-JNIEXPORT jintArray JNICALL
+JNIEXPORT jint JNICALL
 Java_com_example_depthai_1android_1jni_1example_MainActivity_detectionImageFromJNI(JNIEnv *env,
                                                                                jobject thiz) {
+    // The detections of the frame imageFromJNI just converted, so the overlay doesn't drift
     std::shared_ptr<dai::ImgDetections> inDet;
-    if(syncNN) {
-        inDet = qDet->get<dai::ImgDetections>();
+    if(synchronizer) {
+        inDet = std::move(syncedDetections);
     } else {
-        inDet = qDet->tryGet<dai::ImgDetections>();
+        try {
+            inDet = qDet->tryGet<dai::ImgDetections>();
+        } catch(const std::exception& e) {
+            log("detectionImageFromJNI: %s", e.what());
+            return -1;
+        }
     }
 
+    // The latest rgb image is never handed out by acquire, so it can be copied while drawing
+    auto& pool = framePools[FRAME_STREAM_RGB];
+    int source = pool->latest();
+    if(source < 0) return -1;
+
+    int slot = pool->acquire();
+    if(slot < 0) return -1;
+
+    std::memcpy(pool->data(slot), pool->data(source), pool->slotBytes());
+
     if(inDet) {
 
-        // Draw detections into the rgb image
-        detections = inDet->detections;
-        draw_detections(detection_img, detections);
+        // Draw detections into the rgb image (RGBA, like the Bitmap)
+        cv::Mat detection_img(previewHeight, previewWidth, CV_8UC4, pool->data(slot));
+        try {
+            draw_detections(detection_img, inDet->detections);
+        } catch(const std::exception& e) {
+            pool->release(slot);
+            log("detectionImageFromJNI: %s", e.what());
+            return -1;
+        }
     }
 
-    // Copy image data to Bitmap int array
-    return cvMatToBmpArray(env, detection_img);
-}
\ No newline at end of file
+    pool->publish(slot);
+    return slot;
+}
+
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_example_depthai_1android_1jni_1example_MainActivity_setLinkStatsEnabled(JNIEnv *env, jobject thiz, jboolean enabled) {
+
+    linkStats.setEnabled(enabled);
+}
+
+extern "C"
+JNIEXPORT jobjectArray JNICALL
+Java_com_example_depthai_1android_1jni_1example_MainActivity_getLinkStatsStreams(JNIEnv *env, jobject thiz) {
+
+    auto snapshot = linkStats.snapshot();
+    jobjectArray names = env->NewObjectArray(static_cast<jsize>(snapshot.streams.size()), env->FindClass("java/lang/String"), nullptr);
+    for(size_t i = 0; i < snapshot.streams.size(); i++) {
+        jstring name = env->NewStringUTF(snapshot.streams[i].name.c_str());
+        env->SetObjectArrayElement(names, static_cast<jsize>(i), name);
+        env->DeleteLocalRef(name);
+    }
+    return names;
+}
+
+// Seconds since enabled (LINK_STATS_ELAPSED_SECONDS in MainActivity), then 4 values for each stream of
+// getLinkStatsStreams(): messages, payload bytes, average and max message age in milliseconds. Empty while disabled.
+extern "C"
+JNIEXPORT jdoubleArray JNICALL
+Java_com_example_depthai_1android_1jni_1example_MainActivity_getLinkStats(JNIEnv *env, jobject thiz) {
+
+    auto snapshot = linkStats.snapshot();
+    std::vector<jdouble> values;
+    if(snapshot.enabled) {
+        values.push_back(snapshot.elapsed.count());
+        for(const auto& stream : snapshot.streams) {
+            values.push_back(static_cast<jdouble>(stream.messages));
+            values.push_back(static_cast<jdouble>(stream.bytes));
+            values.push_back(stream.averageAge.count() / 1000.0);
+            values.push_back(stream.maxAge.count() / 1000.0);
+        }
+    }
+    jdoubleArray result = env->NewDoubleArray(static_cast<jsize>(values.size()));
+    env->SetDoubleArrayRegion(result, 0, static_cast<jsize>(values.size()), values.data());
+    return result;
+}
+
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_example_depthai_1android_1jni_1example_MainActivity_setTracingEnabled(JNIEnv *env, jobject thiz, jboolean enabled) {
+
+    trace::setEnabled(enabled);
+}
+
+// Writes the recorded trace as Chrome trace JSON, e.g. into getCacheDir(), for ui.perfetto.dev
+extern "C"
+JNIEXPORT jboolean JNICALL
+Java_com_example_depthai_1android_1jni_1example_MainActivity_dumpTrace(JNIEnv *env, jobject thiz, jstring path) {
+
+    const char* chars = env->GetStringUTFChars(path, nullptr);
+    bool written = trace::dump(chars);
+    env->ReleaseStringUTFChars(path, chars);
+    return static_cast<jboolean>(written);
+}
@@ -0,0 +1,213 @@
+#include "pixel_pack.h"
+
+#if defined(__aarch64__) || defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define PIXEL_PACK_NEON
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+    #define PIXEL_PACK_X86
+#endif
+
+namespace {
+
+using PlanarKernel = void (*)(const uint8_t*, const uint8_t*, const uint8_t*, uint8_t*, size_t);
+
+#ifdef PIXEL_PACK_NEON
+
+void packInterleavedNeon(const uint8_t* src, uint8_t* dst, size_t pixels, PixelOrder order) {
+    const uint8x16_t alpha = vdupq_n_u8(255);
+    size_t i = 0;
+    for(; i + 16 <= pixels; i += 16) {
+        uint8x16x3_t in = vld3q_u8(src + 3 * i);
+        uint8x16x4_t out;
+        if(order == PixelOrder::RGB) {
+            out.val[0] = in.val[0];
+            out.val[2] = in.val[2];
+        } else {
+            out.val[0] = in.val[2];
+            out.val[2] = in.val[0];
+        }
+        out.val[1] = in.val[1];
+        out.val[3] = alpha;
+        vst4q_u8(dst + 4 * i, out);
+    }
+    packInterleavedToRgbaScalar(src + 3 * i, dst + 4 * i, pixels - i, order);
+}
+
+void packPlanarNeon(const uint8_t* r, const uint8_t* g, const uint8_t* b, uint8_t* dst, size_t pixels) {
+    const uint8x16_t alpha = vdupq_n_u8(255);
+    size_t i = 0;
+    for(; i + 16 <= pixels; i += 16) {
+        uint8x16x4_t out;
+        out.val[0] = vld1q_u8(r + i);
+        out.val[1] = vld1q_u8(g + i);
+        out.val[2] = vld1q_u8(b + i);
+        out.val[3] = alpha;
+        vst4q_u8(dst + 4 * i, out);
+    }
+    packPlanarToRgbaScalar(r + i, g + i, b + i, dst + 4 * i, pixels - i);
+}
+
+#endif
+
+#ifdef PIXEL_PACK_X86
+
+__attribute__((target("ssse3"))) void packInterleavedSsse3(const uint8_t* src, uint8_t* dst, size_t pixels, PixelOrder order) {
+    const __m128i shuffle = order == PixelOrder::RGB ? _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1)
+                                                     : _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000));
+    size_t i = 0;
+    // Each 16 byte load covers 4 pixels (12 bytes), stop early so the last load stays inside the source
+    for(; i + 6 <= pixels; i += 4) {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 3 * i));
+        __m128i out = _mm_or_si128(_mm_shuffle_epi8(in, shuffle), alpha);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4 * i), out);
+    }
+    packInterleavedToRgbaScalar(src + 3 * i, dst + 4 * i, pixels - i, order);
+}
+
+__attribute__((target("sse2"))) void packPlanarSse2(const uint8_t* r, const uint8_t* g, const uint8_t* b, uint8_t* dst, size_t pixels) {
+    const __m128i alpha = _mm_set1_epi8(-1);
+    size_t i = 0;
+    for(; i + 16 <= pixels; i += 16) {
+        __m128i vr = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r + i));
+        __m128i vg = _mm_loadu_si128(reinterpret_cast<const __m128i*>(g + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        __m128i rgLo = _mm_unpacklo_epi8(vr, vg);
+        __m128i rgHi = _mm_unpackhi_epi8(vr, vg);
+        __m128i baLo = _mm_unpacklo_epi8(vb, alpha);
+        __m128i baHi = _mm_unpackhi_epi8(vb, alpha);
+        __m128i* out = reinterpret_cast<__m128i*>(dst + 4 * i);
+        _mm_storeu_si128(out, _mm_unpacklo_epi16(rgLo, baLo));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(rgLo, baLo));
+        _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(rgHi, baHi));
+        _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(rgHi, baHi));
+    }
+    packPlanarToRgbaScalar(r + i, g + i, b + i, dst + 4 * i, pixels - i);
+}
+
+__attribute__((target("avx2"))) void packInterleavedAvx2(const uint8_t* src, uint8_t* dst, size_t pixels, PixelOrder order) {
+    const __m128i shuffle128 = order == PixelOrder::RGB ? _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1)
+                                                        : _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+    const __m256i shuffle = _mm256_broadcastsi128_si256(shuffle128);
+    const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+    size_t i = 0;
+    // Two 16 byte loads per 8 pixels, the second one reads 4 bytes past the 8th pixel
+    for(; i + 10 <= pixels; i += 8) {
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 3 * i));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 3 * i + 12));
+        __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        __m256i out = _mm256_or_si256(_mm256_shuffle_epi8(in, shuffle), alpha);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 4 * i), out);
+    }
+    packInterleavedToRgbaScalar(src + 3 * i, dst + 4 * i, pixels - i, order);
+}
+
+__attribute__((target("avx2"))) void packPlanarAvx2(const uint8_t* r, const uint8_t* g, const uint8_t* b, uint8_t* dst, size_t pixels) {
+    const __m256i alpha = _mm256_set1_epi8(-1);
+    size_t i = 0;
+    for(; i + 32 <= pixels; i += 32) {
+        __m256i vr = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + i));
+        __m256i vg = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(g + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        // Unpacks work per 128 bit lane, so each result holds pixels n..n+3 and n+16..n+19
+        __m256i rgLo = _mm256_unpacklo_epi8(vr, vg);
+        __m256i rgHi = _mm256_unpackhi_epi8(vr, vg);
+        __m256i baLo = _mm256_unpacklo_epi8(vb, alpha);
+        __m256i baHi = _mm256_unpackhi_epi8(vb, alpha);
+        __m256i p0 = _mm256_unpacklo_epi16(rgLo, baLo);
+        __m256i p1 = _mm256_unpackhi_epi16(rgLo, baLo);
+        __m256i p2 = _mm256_unpacklo_epi16(rgHi, baHi);
+        __m256i p3 = _mm256_unpackhi_epi16(rgHi, baHi);
+        __m256i* out = reinterpret_cast<__m256i*>(dst + 4 * i);
+        _mm256_storeu_si256(out, _mm256_permute2x128_si256(p0, p1, 0x20));
+        _mm256_storeu_si256(out + 1, _mm256_permute2x128_si256(p2, p3, 0x20));
+        _mm256_storeu_si256(out + 2, _mm256_permute2x128_si256(p0, p1, 0x31));
+        _mm256_storeu_si256(out + 3, _mm256_permute2x128_si256(p2, p3, 0x31));
+    }
+    packPlanarSse2(r + i, g + i, b + i, dst + 4 * i, pixels - i);
+}
+
+#endif
+
+const PackKernels& kernels() {
+    static const PackKernels selected = availablePackKernels().front();
+    return selected;
+}
+
+}  // namespace
+
+void packInterleavedToRgbaScalar(const uint8_t* src, uint8_t* dst, size_t pixels, PixelOrder order) {
+    int first = order == PixelOrder::RGB ? 0 : 2;
+    int last = 2 - first;
+    for(size_t i = 0; i < pixels; i++) {
+        dst[4 * i] = src[3 * i + first];
+        dst[4 * i + 1] = src[3 * i + 1];
+        dst[4 * i + 2] = src[3 * i + last];
+        dst[4 * i + 3] = 255;
+    }
+}
+
+void packPlanarToRgbaScalar(const uint8_t* r, const uint8_t* g, const uint8_t* b, uint8_t* dst, size_t pixels) {
+    for(size_t i = 0; i < pixels; i++) {
+        dst[4 * i] = r[i];
+        dst[4 * i + 1] = g[i];
+        dst[4 * i + 2] = b[i];
+        dst[4 * i + 3] = 255;
+    }
+}
+
+void packInterleavedToRgba(const uint8_t* src, uint8_t* dst, size_t pixels, PixelOrder order) {
+    kernels().interleaved(src, dst, pixels, order);
+}
+
+void packPlanarToRgba(const uint8_t* r, const uint8_t* g, const uint8_t* b, uint8_t* dst, size_t pixels) {
+    kernels().planar(r, g, b, dst, pixels);
+}
+
+void packPlanarImageToRgba(const uint8_t* r, const uint8_t* g, const uint8_t* b, size_t srcStride,
+                           size_t width, size_t height, uint8_t* dst, size_t dstStride) {
+    PlanarKernel planar = kernels().planar;
+
+    // Tightly packed planes are one long row
+    if(srcStride == width && dstStride == width * 4) {
+        width *= height;
+        height = 1;
+    }
+
+    for(size_t y = 0; y < height; y++) {
+        const size_t offset = y * srcStride;
+        planar(r + offset, g + offset, b + offset, dst + y * dstStride, width);
+    }
+}
+
+void packGrayToRgba(const uint8_t* src, uint8_t* dst, size_t pixels) {
+    for(size_t i = 0; i < pixels; i++) {
+        dst[4 * i] = src[i];
+        dst[4 * i + 1] = src[i];
+        dst[4 * i + 2] = src[i];
+        dst[4 * i + 3] = 255;
+    }
+}
+
+const char* packKernelName() {
+    return kernels().name;
+}
+
+std::vector<PackKernels> availablePackKernels() {
+    std::vector<PackKernels> available;
+#if defined(PIXEL_PACK_NEON)
+    available.push_back({packInterleavedNeon, packPlanarNeon, "neon"});
+#elif defined(PIXEL_PACK_X86)
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")) {
+        available.push_back({packInterleavedAvx2, packPlanarAvx2, "avx2"});
+    }
+    if(__builtin_cpu_supports("ssse3")) {
+        available.push_back({packInterleavedSsse3, packPlanarSse2, "ssse3"});
+    }
+    available.push_back({packInterleavedToRgbaScalar, packPlanarSse2, "sse2"});
+#endif
+    available.push_back({packInterleavedToRgbaScalar, packPlanarToRgbaScalar, "scalar"});
+    return available;
+}
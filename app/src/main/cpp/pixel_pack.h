@@ -0,0 +1,46 @@
+#ifndef DEPTHAI_ANDROID_JNI_EXAMPLE_PIXEL_PACK_H
+#define DEPTHAI_ANDROID_JNI_EXAMPLE_PIXEL_PACK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Channel order of 8-bit 3 channel source pixels
+enum class PixelOrder {
+    RGB,
+    BGR
+};
+
+// Packs interleaved 3 byte pixels into RGBA bytes (alpha 255), the memory layout of an ARGB_8888 Bitmap.
+// Passing an RGB source as BGR gives BGRA bytes instead, which is a little endian ARGB int (Bitmap.setPixels).
+void packInterleavedToRgba(const uint8_t* src, uint8_t* dst, size_t pixels, PixelOrder order);
+
+// Packs three 8-bit planes into RGBA bytes (alpha 255)
+void packPlanarToRgba(const uint8_t* r, const uint8_t* g, const uint8_t* b, uint8_t* dst, size_t pixels);
+
+// Packs three 8-bit planes with a row pitch of srcStride bytes into an RGBA image with a row pitch of dstStride bytes
+void packPlanarImageToRgba(const uint8_t* r, const uint8_t* g, const uint8_t* b, size_t srcStride,
+                           size_t width, size_t height, uint8_t* dst, size_t dstStride);
+
+// Replicates 8-bit gray values into RGBA bytes (alpha 255)
+void packGrayToRgba(const uint8_t* src, uint8_t* dst, size_t pixels);
+
+// Scalar reference implementations, used for the tails of the vector kernels
+void packInterleavedToRgbaScalar(const uint8_t* src, uint8_t* dst, size_t pixels, PixelOrder order);
+void packPlanarToRgbaScalar(const uint8_t* r, const uint8_t* g, const uint8_t* b, uint8_t* dst, size_t pixels);
+
+// Name of the kernel set selected at runtime ("neon", "avx2", "ssse3", "sse2" or "scalar")
+const char* packKernelName();
+
+// One set of kernels with the signatures of packInterleavedToRgba and packPlanarToRgba
+struct PackKernels {
+    void (*interleaved)(const uint8_t* src, uint8_t* dst, size_t pixels, PixelOrder order);
+    void (*planar)(const uint8_t* r, const uint8_t* g, const uint8_t* b, uint8_t* dst, size_t pixels);
+    const char* name;
+};
+
+// Every kernel set this CPU supports, the one selected at runtime first and the scalar one last.
+// For testing and benchmarking the vector kernels against each other.
+std::vector<PackKernels> availablePackKernels();
+
+#endif //DEPTHAI_ANDROID_JNI_EXAMPLE_PIXEL_PACK_H
@@ -0,0 +1,16 @@
+#include "reader_thread_policy.h"
+
+ReaderThreadPolicy::~ReaderThreadPolicy() {
+    std::lock_guard<std::mutex> lock(mtx);
+    for(auto& callback : callbacks) {
+        callback.first->removeCallback(callback.second);
+    }
+}
+
+void ReaderThreadPolicy::attach(const std::shared_ptr<dai::DataOutputQueue>& queue) {
+    auto once = std::make_shared<std::once_flag>();
+    auto policy = this->policy;
+    auto callback = [policy, once](std::shared_ptr<dai::ADatatype>) { std::call_once(*once, [&policy]() { applyThreadPolicy(*policy); }); };
+    std::lock_guard<std::mutex> lock(mtx);
+    callbacks.emplace_back(queue, queue->addCallback(std::function<void(std::shared_ptr<dai::ADatatype>)>(callback)));
+}
@@ -0,0 +1,29 @@
+#ifndef DEPTHAI_ANDROID_JNI_EXAMPLE_READER_THREAD_POLICY_H
+#define DEPTHAI_ANDROID_JNI_EXAMPLE_READER_THREAD_POLICY_H
+
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "depthai/depthai.hpp"
+
+#include "thread_policy.h"
+
+// Applies policy to the reading thread of each DataOutputQueue (one per queue, created by depthai and
+// not configurable otherwise), from a callback that does nothing after its first call.
+class ReaderThreadPolicy {
+   public:
+    explicit ReaderThreadPolicy(ThreadPolicy policy) : policy(std::make_shared<ThreadPolicy>(std::move(policy))) {}
+    ~ReaderThreadPolicy();
+
+    void attach(const std::shared_ptr<dai::DataOutputQueue>& queue);
+
+   private:
+    // Shared with the callbacks, which may still run while the queues are being detached
+    std::shared_ptr<const ThreadPolicy> policy;
+    std::mutex mtx;
+    std::vector<std::pair<std::shared_ptr<dai::DataOutputQueue>, int>> callbacks;
+};
+
+#endif //DEPTHAI_ANDROID_JNI_EXAMPLE_READER_THREAD_POLICY_H
@@ -0,0 +1,155 @@
+#ifndef DEPTHAI_ANDROID_JNI_EXAMPLE_SPSC_QUEUE_H
+#define DEPTHAI_ANDROID_JNI_EXAMPLE_SPSC_QUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+
+#include "wait_signal.h"
+
+// Bounded lock-free queue with the maxSize/blocking/destruct semantics of dai::LockingQueue,
+// for one producer (the XLink reading thread) and one consumer (the JNI caller).
+// Cells carry a sequence number (Vyukov's bounded queue), so a non-blocking producer can drop the
+// oldest message by taking it itself, while the consumer stays lock-free. Push and pop take
+// no lock and don't notify unless the other side is waiting.
+// Unlike LockingQueue the size is fixed at construction, and maxSize 0 is treated as 1.
+template <typename T>
+class SpscQueue {
+   public:
+    // One spare cell, so a full queue and a cell still being read by the consumer are told apart
+    explicit SpscQueue(unsigned maxSize, bool blocking = true)
+        : maxSize(std::max(maxSize, 1u)), numCells(this->maxSize + 1), cells(new Cell[numCells]), blocking(blocking) {
+        for(size_t i = 0; i < numCells; i++) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    unsigned getMaxSize() const {
+        return static_cast<unsigned>(maxSize);
+    }
+
+    bool getBlocking() const {
+        return blocking;
+    }
+
+    // Wakes up and fails every waiting and later push/pop
+    void destruct() {
+        if(!destructed.exchange(true)) {
+            signalPush.notify();
+            signalPop.notify();
+        }
+    }
+
+    bool isDestructed() const {
+        return destructed.load();
+    }
+
+    // Producer only. Blocks while full if blocking, otherwise overwrites the oldest message.
+    bool push(T data) {
+        // Only the producer moves tail
+        size_t pos = tail.load(std::memory_order_relaxed);
+        Cell& cell = cells[pos % numCells];
+        for(;;) {
+            if(destructed) return false;
+            if(pos - head.load(std::memory_order_relaxed) >= maxSize) {
+                if(blocking) {
+                    signalPop.wait([&]() { return pos - head.load(std::memory_order_relaxed) < maxSize || destructed; });
+                } else {
+                    // Full, so the oldest message is at pos - maxSize. If the consumer takes it first there is room anyway.
+                    T dropped;
+                    tryTake(pos - maxSize, dropped);
+                }
+                continue;
+            }
+            if(cell.sequence.load(std::memory_order_acquire) == pos) break;
+            // The consumer took the previous message of this cell and is still moving it out
+            std::this_thread::yield();
+        }
+
+        cell.value = std::move(data);
+        cell.sequence.store(pos + 1, std::memory_order_release);
+        tail.store(pos + 1, std::memory_order_relaxed);
+        signalPush.notify();
+        return true;
+    }
+
+    // Returns false if empty
+    bool tryPop(T& value) {
+        size_t pos = head.load(std::memory_order_relaxed);
+        while(!tryTake(pos, value)) {
+            size_t current = head.load(std::memory_order_relaxed);
+            if(current == pos) return false;
+            pos = current;
+        }
+        return true;
+    }
+
+    bool waitAndPop(T& value) {
+        while(!tryPop(value)) {
+            if(destructed) return false;
+            signalPush.wait([this]() { return !empty() || destructed; });
+        }
+        return true;
+    }
+
+    template <typename Rep, typename Period>
+    bool tryWaitAndPop(T& value, std::chrono::duration<Rep, Period> timeout) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while(!tryPop(value)) {
+            if(destructed) return false;
+            auto remaining = deadline - std::chrono::steady_clock::now();
+            if(remaining <= remaining.zero()) return false;
+            signalPush.waitFor([this]() { return !empty() || destructed; }, remaining);
+        }
+        return true;
+    }
+
+    bool empty() const {
+        size_t pos = head.load(std::memory_order_acquire);
+        return cells[pos % numCells].sequence.load(std::memory_order_acquire) != pos + 1;
+    }
+
+   private:
+    // Takes the message at pos if it is written and still the oldest one
+    bool tryTake(size_t pos, T& value) {
+        Cell& cell = cells[pos % numCells];
+        if(cell.sequence.load(std::memory_order_acquire) != pos + 1) return false;
+        if(!head.compare_exchange_strong(pos, pos + 1, std::memory_order_relaxed)) return false;
+
+        value = std::move(cell.value);
+        cell.value = T();
+        cell.sequence.store(pos + numCells, std::memory_order_release);
+        signalPop.notify();
+        return true;
+    }
+
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+
+    // Keeps the producer and consumer indices on separate cache lines
+    static constexpr size_t cacheLine = 64;
+
+    const size_t maxSize;
+    const size_t numCells;
+    std::unique_ptr<Cell[]> cells;
+    const bool blocking;
+    std::atomic<bool> destructed{false};
+
+    char padHead[cacheLine];
+    std::atomic<size_t> head{0};
+    char padTail[cacheLine - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> tail{0};
+    char padEnd[cacheLine - sizeof(std::atomic<size_t>)];
+
+    WaitSignal signalPush;
+    WaitSignal signalPop;
+};
+
+#endif //DEPTHAI_ANDROID_JNI_EXAMPLE_SPSC_QUEUE_H
@@ -0,0 +1,41 @@
+#include "startup_timeline.h"
+#include "logging.h"
+
+namespace {
+
+const char* const phaseNames[STARTUP_PHASE_COUNT] = {"device boot", "model load", "pipeline build", "pipeline start", "first frame"};
+
+}  // namespace
+
+void StartupTimeline::reset() {
+    for(int i = 0; i < STARTUP_PHASE_COUNT; i++) {
+        begins[i] = -1;
+        ends[i] = -1;
+    }
+    start = std::chrono::steady_clock::now();
+    begins[STARTUP_FIRST_FRAME] = 0;
+}
+
+void StartupTimeline::begin(StartupPhase phase) {
+    begins[phase] = now();
+}
+
+void StartupTimeline::end(StartupPhase phase) {
+    std::int64_t expected = -1;
+    ends[phase].compare_exchange_strong(expected, now());
+}
+
+bool StartupTimeline::isEnded(StartupPhase phase) const {
+    return ends[phase] >= 0;
+}
+
+void StartupTimeline::report() const {
+    for(int i = 0; i < STARTUP_PHASE_COUNT; i++) {
+        if(begins[i] < 0 || ends[i] < 0) continue;
+        log("Startup %s: %lld - %lld ms", phaseNames[i], static_cast<long long>(begins[i] / 1000), static_cast<long long>(ends[i] / 1000));
+    }
+}
+
+std::int64_t StartupTimeline::now() const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
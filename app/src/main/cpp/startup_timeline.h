@@ -0,0 +1,48 @@
+#ifndef DEPTHAI_ANDROID_JNI_EXAMPLE_STARTUP_TIMELINE_H
+#define DEPTHAI_ANDROID_JNI_EXAMPLE_STARTUP_TIMELINE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Startup phases, logged by StartupTimeline::report()
+enum StartupPhase {
+    // dai::Device construction: firmware boot and XLink connection
+    STARTUP_DEVICE_BOOT = 0,
+    // Model blob read and parsed, overlaps the device boot
+    STARTUP_MODEL_LOAD,
+    STARTUP_PIPELINE_BUILD,
+    // startPipeline: schema and asset upload
+    STARTUP_PIPELINE_START,
+    // From startDevice until the first rgb frame is handed to Java
+    STARTUP_FIRST_FRAME,
+    STARTUP_PHASE_COUNT
+};
+
+// Begin and end of each phase, relative to the start of startDevice. Phases may run on other threads.
+class StartupTimeline {
+   public:
+    StartupTimeline() {
+        reset();
+    }
+
+    // Clears all phases, the time base is now
+    void reset();
+
+    void begin(StartupPhase phase);
+    // Only the first end counts, so it can be called per frame for STARTUP_FIRST_FRAME
+    void end(StartupPhase phase);
+    bool isEnded(StartupPhase phase) const;
+
+    // Logs the phases that ended
+    void report() const;
+
+   private:
+    std::int64_t now() const;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::atomic<std::int64_t> begins[STARTUP_PHASE_COUNT];
+    std::atomic<std::int64_t> ends[STARTUP_PHASE_COUNT];
+};
+
+#endif //DEPTHAI_ANDROID_JNI_EXAMPLE_STARTUP_TIMELINE_H
@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "thread_policy.h"
+#include "logging.h"
+
+namespace {
+
+// kHz, 0 if unknown
+long maxFrequency(int cpu) {
+    char path[96];
+    std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", cpu);
+    FILE* file = std::fopen(path, "r");
+    if(file == nullptr) return 0;
+    long frequency = 0;
+    if(std::fscanf(file, "%ld", &frequency) != 1) frequency = 0;
+    std::fclose(file);
+    return frequency;
+}
+
+}  // namespace
+
+ThreadPolicy ThreadPolicy::fastCores() {
+    ThreadPolicy policy;
+    policy.cpus = fastCpus();
+    policy.setNice = true;
+    // Same as Android's THREAD_PRIORITY_URGENT_DISPLAY
+    policy.nice = -8;
+    return policy;
+}
+
+std::vector<int> fastCpus() {
+    long count = sysconf(_SC_NPROCESSORS_CONF);
+    std::vector<long> frequencies;
+    for(int cpu = 0; cpu < count; cpu++) frequencies.push_back(maxFrequency(cpu));
+
+    std::vector<int> cpus;
+    auto slowest = std::min_element(frequencies.begin(), frequencies.end());
+    bool known = slowest != frequencies.end() && *slowest > 0;
+    for(int cpu = 0; cpu < count; cpu++) {
+        if(!known || frequencies[cpu] > *slowest) cpus.push_back(cpu);
+    }
+    // A single cluster
+    if(cpus.empty()) {
+        for(int cpu = 0; cpu < count; cpu++) cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+bool applyThreadPolicy(const ThreadPolicy& policy) {
+    bool applied = true;
+
+    if(!policy.cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for(int cpu : policy.cpus) CPU_SET(cpu, &set);
+        if(sched_setaffinity(0, sizeof(set), &set) != 0) {
+            log("Couldn't set thread affinity: %s", std::strerror(errno));
+            applied = false;
+        }
+    }
+
+    // Per thread on Linux, the tid is used as the process id
+    if(policy.setNice) {
+        if(setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), policy.nice) != 0) {
+            log("Couldn't set thread nice value %d: %s", policy.nice, std::strerror(errno));
+            applied = false;
+        }
+    }
+    return applied;
+}
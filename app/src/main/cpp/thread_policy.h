@@ -0,0 +1,24 @@
+#ifndef DEPTHAI_ANDROID_JNI_EXAMPLE_THREAD_POLICY_H
+#define DEPTHAI_ANDROID_JNI_EXAMPLE_THREAD_POLICY_H
+
+#include <vector>
+
+// Scheduling of a thread: cores it may run on and its priority
+struct ThreadPolicy {
+    // Allowed cores, empty leaves the affinity unchanged
+    std::vector<int> cpus;
+    // Nice value, applied if setNice (negative values need no permission for the app's own threads on Android)
+    bool setNice = false;
+    int nice = 0;
+
+    // Big cores (all but the slowest cluster on big.LITTLE) and a raised priority, for the XLink readers
+    static ThreadPolicy fastCores();
+};
+
+// Applies policy to the calling thread. Returns false if a part was refused, the rest is still applied.
+bool applyThreadPolicy(const ThreadPolicy& policy);
+
+// Cores outside the slowest cluster by cpuinfo_max_freq, all cores if they are the same (or unknown)
+std::vector<int> fastCpus();
+
+#endif //DEPTHAI_ANDROID_JNI_EXAMPLE_THREAD_POLICY_H
@@ -0,0 +1,230 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "trace.h"
+
+namespace trace {
+
+namespace {
+
+constexpr std::size_t nameWords = (maxNameLength + 1) / sizeof(std::uint64_t);
+
+// Written by its thread only, read by dumps as a seqlock: odd sequence while being written
+struct Event {
+    std::atomic<std::uint32_t> sequence{0};
+    std::atomic<std::uint64_t> name[nameWords];
+    std::atomic<std::int64_t> begin{0};
+    // -1 for instant events
+    std::atomic<std::int64_t> duration{0};
+};
+
+struct ThreadBuffer {
+    long tid = 0;
+    // Guarded by the registry mutex
+    std::string name;
+    bool exited = false;
+    std::atomic<std::uint64_t> head{0};
+    // Events before this index were cleared
+    std::atomic<std::uint64_t> first{0};
+    Event events[eventsPerThread];
+};
+
+// Buffers of exited threads kept for dumps, each holds eventsPerThread events (about 73 kB)
+constexpr std::size_t maxExitedBuffers = 8;
+
+std::atomic<bool> enabled{false};
+
+// Buffers stay registered after their thread exits, so its events are still dumped.
+// Only the newest maxExitedBuffers of them are kept, and none without events.
+std::mutex registryMtx;
+std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+
+// Called with the registry mutex held
+void pruneExited() {
+    buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+                                 [](const std::shared_ptr<ThreadBuffer>& buffer) {
+                                     return buffer->exited && buffer->first.load(std::memory_order_relaxed) == buffer->head.load(std::memory_order_acquire);
+                                 }),
+                  buffers.end());
+    std::size_t exited = std::count_if(buffers.begin(), buffers.end(), [](const std::shared_ptr<ThreadBuffer>& buffer) { return buffer->exited; });
+    for(auto it = buffers.begin(); exited > maxExitedBuffers && it != buffers.end();) {
+        if((*it)->exited) {
+            it = buffers.erase(it);
+            exited--;
+        } else {
+            ++it;
+        }
+    }
+}
+
+// The calling thread's buffer, created by its first event, and its name until then
+struct ThreadState {
+    ThreadBuffer* buffer = nullptr;
+    std::string name;
+
+    ~ThreadState() {
+        if(buffer == nullptr) return;
+        std::lock_guard<std::mutex> lock(registryMtx);
+        buffer->exited = true;
+    }
+};
+
+thread_local ThreadState threadState;
+
+ThreadBuffer& threadBuffer() {
+    if(threadState.buffer == nullptr) {
+        auto created = std::make_shared<ThreadBuffer>();
+        created->tid = static_cast<long>(syscall(SYS_gettid));
+        std::lock_guard<std::mutex> lock(registryMtx);
+        created->name = threadState.name;
+        pruneExited();
+        buffers.push_back(created);
+        threadState.buffer = created.get();
+    }
+    return *threadState.buffer;
+}
+
+std::int64_t microseconds(dai::Clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+}
+
+void record(const char* name, std::int64_t begin, std::int64_t duration) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::uint64_t index = buffer.head.load(std::memory_order_relaxed);
+    Event& event = buffer.events[index % eventsPerThread];
+
+    std::uint64_t words[nameWords] = {};
+    std::strncpy(reinterpret_cast<char*>(words), name, maxNameLength);
+
+    std::uint32_t sequence = event.sequence.load(std::memory_order_relaxed);
+    event.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for(std::size_t i = 0; i < nameWords; i++) event.name[i].store(words[i], std::memory_order_relaxed);
+    event.begin.store(begin, std::memory_order_relaxed);
+    event.duration.store(duration, std::memory_order_relaxed);
+    event.sequence.store(sequence + 2, std::memory_order_release);
+    buffer.head.store(index + 1, std::memory_order_release);
+}
+
+// Returns false if the event is being overwritten
+bool read(const Event& event, char (&name)[nameWords * sizeof(std::uint64_t)], std::int64_t& begin, std::int64_t& duration) {
+    std::uint32_t sequence = event.sequence.load(std::memory_order_acquire);
+    if(sequence & 1) return false;
+    std::uint64_t words[nameWords];
+    for(std::size_t i = 0; i < nameWords; i++) words[i] = event.name[i].load(std::memory_order_relaxed);
+    begin = event.begin.load(std::memory_order_relaxed);
+    duration = event.duration.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if(event.sequence.load(std::memory_order_relaxed) != sequence) return false;
+    std::memcpy(name, words, sizeof(words));
+    name[maxNameLength] = '\0';
+    return true;
+}
+
+void appendEscaped(std::string& json, const char* text) {
+    for(; *text; text++) {
+        char c = *text;
+        if(c == '"' || c == '\\') {
+            json += '\\';
+            json += c;
+        } else if(static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            json += escaped;
+        } else {
+            json += c;
+        }
+    }
+}
+
+}  // namespace
+
+void setEnabled(bool enable) {
+    enabled.store(enable, std::memory_order_relaxed);
+}
+
+bool isEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+void clear() {
+    std::lock_guard<std::mutex> lock(registryMtx);
+    for(auto& buffer : buffers) {
+        buffer->first.store(buffer->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+    pruneExited();
+}
+
+// Only remembered until the thread records its first event, threads that never do get no buffer
+void setThreadName(const std::string& name) {
+    threadState.name = name;
+    if(threadState.buffer == nullptr) return;
+    std::lock_guard<std::mutex> lock(registryMtx);
+    threadState.buffer->name = name;
+}
+
+void complete(const char* name, dai::Clock::time_point begin) {
+    if(!isEnabled()) return;
+    std::int64_t start = microseconds(begin);
+    record(name, start, microseconds(dai::Clock::now()) - start);
+}
+
+void instant(const char* name) {
+    if(!isEnabled()) return;
+    record(name, microseconds(dai::Clock::now()), -1);
+}
+
+std::string toChromeJson() {
+    std::string json = "{\"traceEvents\":[";
+    bool firstEvent = true;
+    char line[160];
+    char name[nameWords * sizeof(std::uint64_t)];
+    long pid = static_cast<long>(getpid());
+
+    std::lock_guard<std::mutex> lock(registryMtx);
+    for(const auto& buffer : buffers) {
+        if(!buffer->name.empty()) {
+            std::snprintf(line, sizeof(line), "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%ld,\"tid\":%ld,\"args\":{\"name\":\"", firstEvent ? "" : ",", pid, buffer->tid);
+            json += line;
+            appendEscaped(json, buffer->name.c_str());
+            json += "\"}}";
+            firstEvent = false;
+        }
+
+        std::uint64_t head = buffer->head.load(std::memory_order_acquire);
+        std::uint64_t first = std::max(buffer->first.load(std::memory_order_relaxed), head > eventsPerThread ? head - eventsPerThread : 0);
+        for(std::uint64_t i = first; i < head; i++) {
+            std::int64_t begin = 0, duration = 0;
+            if(!read(buffer->events[i % eventsPerThread], name, begin, duration)) continue;
+            json += firstEvent ? "{\"name\":\"" : ",{\"name\":\"";
+            appendEscaped(json, name);
+            if(duration < 0) {
+                std::snprintf(line, sizeof(line), "\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%lld,\"pid\":%ld,\"tid\":%ld}", static_cast<long long>(begin), pid, buffer->tid);
+            } else {
+                std::snprintf(line, sizeof(line), "\",\"ph\":\"X\",\"ts\":%lld,\"dur\":%lld,\"pid\":%ld,\"tid\":%ld}", static_cast<long long>(begin),
+                              static_cast<long long>(duration), pid, buffer->tid);
+            }
+            json += line;
+            firstEvent = false;
+        }
+    }
+    json += "]}";
+    return json;
+}
+
+bool dump(const std::string& path) {
+    std::string json = toChromeJson();
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if(file == nullptr) return false;
+    bool ok = std::fwrite(json.data(), 1, json.size(), file) == json.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+}  // namespace trace
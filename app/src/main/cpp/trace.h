@@ -0,0 +1,55 @@
+#ifndef DEPTHAI_ANDROID_JNI_EXAMPLE_TRACE_H
+#define DEPTHAI_ANDROID_JNI_EXAMPLE_TRACE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "depthai/utility/Clock.hpp"
+
+// Lightweight tracing exported as Chrome trace JSON (chrome://tracing, ui.perfetto.dev).
+// Each thread writes its events into its own ring buffer without locking, the oldest events are
+// overwritten. Timestamps come from dai::Clock (monotonic). While disabled a span costs one atomic load.
+namespace trace {
+
+constexpr std::size_t maxNameLength = 47;
+constexpr std::size_t eventsPerThread = 1024;
+
+void setEnabled(bool enabled);
+bool isEnabled();
+// Drops all recorded events
+void clear();
+
+// Name shown for the calling thread
+void setThreadName(const std::string& name);
+
+// A span from begin to now, names are copied (and truncated to maxNameLength)
+void complete(const char* name, dai::Clock::time_point begin);
+void instant(const char* name);
+
+// All recorded events as {"traceEvents": [...]}, e.g. to write into a .json file
+std::string toChromeJson();
+// Returns false if the file couldn't be written
+bool dump(const std::string& path);
+
+// Records the time from construction to destruction
+class Span {
+   public:
+    explicit Span(const char* name) : name(isEnabled() ? name : nullptr) {
+        if(this->name) begin = dai::Clock::now();
+    }
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+    ~Span() {
+        if(name) complete(name, begin);
+    }
+
+   private:
+    const char* name;
+    dai::Clock::time_point begin;
+};
+
+}  // namespace trace
+
+#endif //DEPTHAI_ANDROID_JNI_EXAMPLE_TRACE_H
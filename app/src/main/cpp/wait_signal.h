@@ -0,0 +1,56 @@
+#ifndef DEPTHAI_ANDROID_JNI_EXAMPLE_WAIT_SIGNAL_H
+#define DEPTHAI_ANDROID_JNI_EXAMPLE_WAIT_SIGNAL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+// Blocks a thread until a predicate holds. Signalling only takes the mutex when a thread
+// is actually waiting, so the common notify (nobody waiting) is a fence and one atomic load.
+class WaitSignal {
+   public:
+    template <typename Predicate>
+    void wait(Predicate ready) {
+        if(ready()) return;
+        std::unique_lock<std::mutex> lock(mtx);
+        waiters.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while(!ready()) cv.wait(lock);
+        waiters.fetch_sub(1);
+    }
+
+    // Returns false if the predicate still doesn't hold after timeout
+    template <typename Predicate, typename Rep, typename Period>
+    bool waitFor(Predicate ready, std::chrono::duration<Rep, Period> timeout) {
+        if(ready()) return true;
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        std::unique_lock<std::mutex> lock(mtx);
+        waiters.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool result = true;
+        while(!ready()) {
+            if(cv.wait_until(lock, deadline) == std::cv_status::timeout) {
+                result = ready();
+                break;
+            }
+        }
+        waiters.fetch_sub(1);
+        return result;
+    }
+
+    // Call after the state the predicate reads has been published
+    void notify() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(waiters.load(std::memory_order_relaxed) == 0) return;
+        std::lock_guard<std::mutex> lock(mtx);
+        cv.notify_all();
+    }
+
+   private:
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::atomic<int> waiters{0};
+};
+
+#endif //DEPTHAI_ANDROID_JNI_EXAMPLE_WAIT_SIGNAL_H
@@ -4,10 +4,16 @@ import android.content.res.AssetManager;
 import android.graphics.Bitmap;
 import android.os.Bundle;
 import android.os.Handler;
+import android.os.SystemClock;
+import android.util.Log;
 import android.view.Window;
 import android.view.WindowManager;
 import android.widget.ImageView;
 
+import java.io.File;
+import java.nio.ByteBuffer;
+import java.util.Locale;
+
 import androidx.appcompat.app.AppCompatActivity;
 
 import com.example.depthai_android_jni_example.databinding.ActivityMainBinding;
@@ -32,6 +38,39 @@ public class MainActivity extends AppCompatActivity {
     private static final int disparityWidth = 640;
     private static final int disparityHeight = 400;
     private static final int framePeriod = 30;
+    // Wait before trying startDevice again, e.g. while no device is plugged in (ms)
+    private static final int startRetryPeriod = 1000;
+
+    // Frame streams, keep in sync with FrameStream in frame_pool.h
+    private static final int RGB_STREAM = 0;
+    private static final int DEPTH_STREAM = 1;
+    // Depth in millimeters, one native order short per pixel (only when raw depth is enabled natively)
+    private static final int RAW_DEPTH_STREAM = 2;
+
+    // Disparity colormaps, keep in sync with Colormap in disparity_colorizer.h
+    private static final int COLORMAP_RAINBOW = 0;
+    private static final int COLORMAP_JET = 1;
+    private static final int COLORMAP_TURBO = 2;
+    private static final int COLORMAP_GRAY = 3;
+
+    // Layout of getLinkStats(), keep in sync with getLinkStats in native-lib.cpp.
+    // The elapsed time is followed by LINK_STATS_PER_STREAM values for each stream of getLinkStatsStreams():
+    // messages, payload bytes, average and max message age (ms, device timestamp to host callback)
+    private static final int LINK_STATS_ELAPSED_SECONDS = 0;
+    private static final int LINK_STATS_STREAMS = 1;
+    private static final int LINK_STATS_PER_STREAM = 4;
+
+    // Debug builds log the link statistics of each stream at this period (ms)
+    private static final String TAG = "MainActivity";
+    private static final int linkStatsLogPeriod = 5000;
+    private long linkStatsLoggedAt;
+
+    // Debug builds record a native trace from startDevice on and write it here in onStop, to open
+    // in ui.perfetto.dev: adb exec-out run-as <package> cat cache/trace.json > trace.json
+    private static final String traceFile = "trace.json";
+
+    // Native frame buffers, filled by the native code and returned by slot index
+    private ByteBuffer[] rgbBuffers, depthBuffers;
 
     private boolean running, firstTime;
 
@@ -74,26 +113,50 @@ public class MainActivity extends AppCompatActivity {
             if(running){
                 if(firstTime){
                     // Start the device
-                    startDevice(yolov5_model_path, rgbWidth, rgbHeight);
+                    setDisparityColormap(COLORMAP_RAINBOW);
+                    if(BuildConfig.DEBUG) {
+                        setTracingEnabled(true);
+                    }
+                    try {
+                        startDevice(yolov5_model_path, rgbWidth, rgbHeight);
+                    } catch(RuntimeException e) {
+                        Log.e(TAG, "startDevice failed, retrying", e);
+                        handler.postDelayed(this, startRetryPeriod);
+                        return;
+                    }
+                    if(BuildConfig.DEBUG) {
+                        setLinkStatsEnabled(true);
+                        linkStatsLoggedAt = SystemClock.elapsedRealtime();
+                    }
                     firstTime = false;
                 }
 
-                int[] rgb = imageFromJNI();
-                if(rgb != null && rgb.length > 0) {
-                    rgb_image.setPixels(rgb, 0, rgbWidth, 0, 0, rgbWidth, rgbHeight);
-                    rgbImageView.setImageBitmap(rgb_image);
+                // Fetched here rather than after startDevice: a recreated activity (e.g. after a rotation)
+                // doesn't start the device again, the native pools outlive it
+                if(rgbBuffers == null) {
+                    rgbBuffers = getFrameBuffers(RGB_STREAM);
+                }
+                if(depthBuffers == null) {
+                    depthBuffers = getFrameBuffers(DEPTH_STREAM);
                 }
 
-                int[] detections_img = detectionImageFromJNI();
-                if(detections_img != null && detections_img.length > 0) {
-                    rgb_image.setPixels(detections_img, 0, rgbWidth, 0, 0, rgbWidth, rgbHeight);
-                    rgbImageView.setImageBitmap(rgb_image);
+                int rgbSlot = imageFromJNI();
+                if(rgbSlot >= 0) {
+                    showFrame(rgbBuffers, RGB_STREAM, rgbSlot, rgb_image, rgbImageView);
                 }
 
-                int[] depth = depthFromJNI();
-                if(depth != null && depth.length > 0) {
-                    depth_image.setPixels(depth, 0, disparityWidth, 0, 0, disparityWidth, disparityHeight);
-                    depthImageView.setImageBitmap(depth_image);
+                int detectionsSlot = detectionImageFromJNI();
+                if(detectionsSlot >= 0) {
+                    showFrame(rgbBuffers, RGB_STREAM, detectionsSlot, rgb_image, rgbImageView);
+                }
+
+                int depthSlot = depthFromJNI();
+                if(depthSlot >= 0) {
+                    showFrame(depthBuffers, DEPTH_STREAM, depthSlot, depth_image, depthImageView);
+                }
+
+                if(BuildConfig.DEBUG) {
+                    logLinkStats();
                 }
 
                 handler.postDelayed(this, framePeriod);
@@ -103,6 +166,44 @@ public class MainActivity extends AppCompatActivity {
         }
     };
 
+    // Copy the native frame buffer into the bitmap and give the slot back to the native side
+    private void showFrame(ByteBuffer[] buffers, int stream, int slot, Bitmap bitmap, ImageView view) {
+        ByteBuffer buffer = buffers[slot];
+        buffer.rewind();
+        bitmap.copyPixelsFromBuffer(buffer);
+        releaseFrame(stream, slot);
+        view.setImageBitmap(bitmap);
+    }
+
+    // Rates since the stats were enabled and message ages (device timestamp to host callback), per stream
+    private void logLinkStats() {
+        long now = SystemClock.elapsedRealtime();
+        if(now - linkStatsLoggedAt < linkStatsLogPeriod) return;
+        linkStatsLoggedAt = now;
+
+        String[] streams = getLinkStatsStreams();
+        double[] stats = getLinkStats();
+        if(stats.length < LINK_STATS_STREAMS + streams.length * LINK_STATS_PER_STREAM) return;
+        double seconds = stats[LINK_STATS_ELAPSED_SECONDS];
+        for(int i = 0; i < streams.length; i++) {
+            int offset = LINK_STATS_STREAMS + i * LINK_STATS_PER_STREAM;
+            Log.d(TAG, String.format(Locale.US, "%s: %.1f msg/s, %.2f MB/s, age %.1f ms (max %.1f ms)", streams[i],
+                    stats[offset] / seconds, stats[offset + 1] / seconds / 1e6, stats[offset + 2], stats[offset + 3]));
+        }
+    }
+
+    @Override
+    protected void onStop() {
+        super.onStop();
+
+        if(BuildConfig.DEBUG) {
+            String path = new File(getCacheDir(), traceFile).getPath();
+            if(dumpTrace(path)) {
+                Log.d(TAG, "Trace written to " + path);
+            }
+        }
+    }
+
     @Override
     protected void onDestroy() {
         super.onDestroy();
@@ -127,7 +228,16 @@ public class MainActivity extends AppCompatActivity {
      * which is packaged with this application.
      */
     public native void startDevice(String model_path, int rgbWidth, int rgbHeight);
-    public native int[] imageFromJNI();
-    public native int[] detectionImageFromJNI();
-    public native int[] depthFromJNI();
+    public native ByteBuffer[] getFrameBuffers(int stream);
+    public native void releaseFrame(int stream, int slot);
+    public native int imageFromJNI();
+    public native int detectionImageFromJNI();
+    public native int depthFromJNI();
+    public native int rawDepthFromJNI();
+    public native void setDisparityColormap(int colormap);
+    public native void setLinkStatsEnabled(boolean enabled);
+    public native String[] getLinkStatsStreams();
+    public native double[] getLinkStats();
+    public native void setTracingEnabled(boolean enabled);
+    public native boolean dumpTrace(String path);
 }
\ No newline at end of file
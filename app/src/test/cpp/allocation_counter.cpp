@@ -0,0 +1,71 @@
+#include <atomic>
+#include <cerrno>
+
+#include "allocation_counter.h"
+
+// glibc's own entry points, the replacements below count and forward to them
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* pointer, std::size_t size);
+void* __libc_memalign(std::size_t alignment, std::size_t size);
+void __libc_free(void* pointer);
+}
+
+namespace {
+
+std::atomic<std::uint64_t> allocations{0};
+std::atomic<std::uint64_t> bytes{0};
+
+void count(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+AllocationCount allocationCount() {
+    AllocationCount result;
+    result.allocations = allocations.load(std::memory_order_relaxed);
+    result.bytes = bytes.load(std::memory_order_relaxed);
+    return result;
+}
+
+extern "C" {
+
+void* malloc(std::size_t size) {
+    count(size);
+    return __libc_malloc(size);
+}
+
+void* calloc(std::size_t number, std::size_t size) {
+    count(number * size);
+    return __libc_calloc(number, size);
+}
+
+void* realloc(void* pointer, std::size_t size) {
+    count(size);
+    return __libc_realloc(pointer, size);
+}
+
+void* memalign(std::size_t alignment, std::size_t size) {
+    count(size);
+    return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(std::size_t alignment, std::size_t size) {
+    count(size);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** result, std::size_t alignment, std::size_t size) {
+    count(size);
+    *result = __libc_memalign(alignment, size);
+    return *result != nullptr ? 0 : ENOMEM;
+}
+
+void free(void* pointer) {
+    __libc_free(pointer);
+}
+
+}  // extern "C"
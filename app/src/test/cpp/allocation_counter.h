@@ -0,0 +1,23 @@
+#ifndef DEPTHAI_ANDROID_JNI_EXAMPLE_ALLOCATION_COUNTER_H
+#define DEPTHAI_ANDROID_JNI_EXAMPLE_ALLOCATION_COUNTER_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Heap allocations of the whole process since it started (malloc, calloc, realloc and the aligned variants,
+// which also covers operator new and cv::fastMalloc). Take the difference of two counts around the measured code.
+struct AllocationCount {
+    std::uint64_t allocations = 0;
+    std::uint64_t bytes = 0;
+};
+
+AllocationCount allocationCount();
+
+inline AllocationCount operator-(const AllocationCount& a, const AllocationCount& b) {
+    AllocationCount difference;
+    difference.allocations = a.allocations - b.allocations;
+    difference.bytes = a.bytes - b.bytes;
+    return difference;
+}
+
+#endif //DEPTHAI_ANDROID_JNI_EXAMPLE_ALLOCATION_COUNTER_H
@@ -0,0 +1,38 @@
+#ifndef DEPTHAI_ANDROID_JNI_EXAMPLE_BENCHMARK_H
+#define DEPTHAI_ANDROID_JNI_EXAMPLE_BENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+// Minimal Google Benchmark style runner: repeats body, doubling the iterations until a run takes
+// at least minTime, then prints the time per iteration and the rate of items (pixels, messages...)
+// processed by one iteration. Returns the seconds per iteration.
+template <typename Body>
+double runBenchmark(const char* name, double itemsPerIteration, const char* items, Body&& body,
+                    std::chrono::duration<double> minTime = std::chrono::milliseconds(300)) {
+    body();  // warm up
+
+    std::uint64_t iterations = 1;
+    for(;;) {
+        auto begin = std::chrono::steady_clock::now();
+        for(std::uint64_t i = 0; i < iterations; i++) body();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+        if(elapsed >= minTime || iterations >= (1ull << 40)) {
+            double seconds = elapsed.count() / static_cast<double>(iterations);
+            std::printf("%-44s %12.3f us %14.2f M%s/s %12llu iterations\n", name, seconds * 1e6, itemsPerIteration / seconds / 1e6, items,
+                        static_cast<unsigned long long>(iterations));
+            return seconds;
+        }
+        iterations *= 2;
+    }
+}
+
+// Keeps the compiler from dropping a computation whose result is otherwise unused
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+#endif //DEPTHAI_ANDROID_JNI_EXAMPLE_BENCHMARK_H
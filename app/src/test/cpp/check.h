@@ -0,0 +1,16 @@
+#ifndef DEPTHAI_ANDROID_JNI_EXAMPLE_CHECK_H
+#define DEPTHAI_ANDROID_JNI_EXAMPLE_CHECK_H
+
+#include <cstdio>
+#include <cstdlib>
+
+// Fails the test (exit code 1) with the location and the condition if it doesn't hold
+#define CHECK(condition)                                                                        \
+    do {                                                                                        \
+        if(!(condition)) {                                                                      \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            std::exit(1);                                                                       \
+        }                                                                                       \
+    } while(0)
+
+#endif //DEPTHAI_ANDROID_JNI_EXAMPLE_CHECK_H
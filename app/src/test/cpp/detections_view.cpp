@@ -0,0 +1,178 @@
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "detections_view.h"
+
+namespace {
+
+// Prefix bytes of the nop encoding (nop/base/encoding_byte.h)
+enum : std::uint8_t {
+    PositiveFixIntMax = 0x7f,
+    U8 = 0x80,
+    U16 = 0x81,
+    U32 = 0x82,
+    U64 = 0x83,
+    I8 = 0x84,
+    I16 = 0x85,
+    I32 = 0x86,
+    I64 = 0x87,
+    F32 = 0x88,
+    Structure = 0xb9,
+    Array = 0xba,
+    NegativeFixIntMin = 0xc0,
+};
+
+// Members of the NOP_STRUCTURE declarations the view decodes
+constexpr std::uint64_t rawImgDetectionsMembers = 4;
+constexpr std::uint64_t imgDetectionMembers = 6;
+constexpr std::uint64_t timestampMembers = 2;
+
+// Bounds checked reader of nop encoded values, throws on malformed data
+class NopReader {
+   public:
+    NopReader(const std::uint8_t* data, std::size_t size, std::size_t offset) : data(data), size(size), offset(offset) {}
+
+    std::size_t position() const {
+        return offset;
+    }
+
+    std::uint64_t readUnsigned() {
+        std::uint8_t prefix = readRaw<std::uint8_t>();
+        if(prefix <= PositiveFixIntMax) return prefix;
+        switch(prefix) {
+            case U8:
+                return readRaw<std::uint8_t>();
+            case U16:
+                return readRaw<std::uint16_t>();
+            case U32:
+                return readRaw<std::uint32_t>();
+            case U64:
+                return readRaw<std::uint64_t>();
+            default:
+                throw error("unsigned integer", prefix);
+        }
+    }
+
+    std::int64_t readSigned() {
+        std::uint8_t prefix = readRaw<std::uint8_t>();
+        if(prefix <= PositiveFixIntMax) return prefix;
+        if(prefix >= NegativeFixIntMin) return static_cast<std::int8_t>(prefix);
+        switch(prefix) {
+            case I8:
+                return readRaw<std::int8_t>();
+            case I16:
+                return readRaw<std::int16_t>();
+            case I32:
+                return readRaw<std::int32_t>();
+            case I64:
+                return readRaw<std::int64_t>();
+            default:
+                throw error("signed integer", prefix);
+        }
+    }
+
+    float readFloat() {
+        std::uint8_t prefix = readRaw<std::uint8_t>();
+        if(prefix != F32) throw error("float", prefix);
+        return readRaw<float>();
+    }
+
+    // Structure and array headers are followed by their member / element count
+    void readStructure(std::uint64_t members) {
+        std::uint8_t prefix = readRaw<std::uint8_t>();
+        if(prefix != Structure) throw error("structure", prefix);
+        if(readUnsigned() != members) throw std::runtime_error("ImgDetections metadata has an unexpected member count");
+    }
+
+    std::uint64_t readArray() {
+        std::uint8_t prefix = readRaw<std::uint8_t>();
+        if(prefix != Array) throw error("array", prefix);
+        return readUnsigned();
+    }
+
+    dai::Timestamp readTimestamp() {
+        dai::Timestamp timestamp;
+        readStructure(timestampMembers);
+        timestamp.sec = readSigned();
+        timestamp.nsec = readSigned();
+        return timestamp;
+    }
+
+   private:
+    // nop writes values in the host byte order, little endian on both sides of the link
+    template <typename T>
+    T readRaw() {
+        if(size - offset < sizeof(T)) throw std::runtime_error("ImgDetections metadata is truncated");
+        T value;
+        std::memcpy(&value, data + offset, sizeof(T));
+        offset += sizeof(T);
+        return value;
+    }
+
+    std::runtime_error error(const char* expected, std::uint8_t prefix) const {
+        return std::runtime_error(std::string("ImgDetections metadata: expected ") + expected + " at offset " + std::to_string(offset - 1)
+                                  + ", found prefix " + std::to_string(prefix));
+    }
+
+    const std::uint8_t* data;
+    std::size_t size;
+    std::size_t offset;
+};
+
+std::int32_t readIntLE(const std::uint8_t* data) {
+    return static_cast<std::int32_t>(data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<std::uint32_t>(data[3]) << 24));
+}
+
+}  // namespace
+
+ImgDetectionsView::ImgDetectionsView(const std::uint8_t* data, std::size_t size) : data(data), dataSize(size) {
+    NopReader reader(data, size, 0);
+    reader.readStructure(rawImgDetectionsMembers);
+    std::uint64_t detections = reader.readArray();
+    first = reader.position();
+
+    // Walk the detections once, so iterating later can't run out of bounds
+    std::size_t offset = first;
+    dai::ImgDetection detection;
+    for(std::uint64_t i = 0; i < detections; i++) {
+        offset = decode(offset, detection);
+    }
+    count = static_cast<std::size_t>(detections);
+
+    reader = NopReader(data, size, offset);
+    sequenceNum = reader.readSigned();
+    ts = reader.readTimestamp();
+    tsDevice = reader.readTimestamp();
+}
+
+ImgDetectionsView ImgDetectionsView::fromPacket(const std::uint8_t* packet, std::size_t size) {
+    // Trailer of StreamMessageParser: ... metadata, datatype (int32 LE), metadata size (int32 LE)
+    if(size < 8) throw std::runtime_error("Packet too small for a message trailer");
+    std::int32_t metadataSize = readIntLE(packet + size - 4);
+    auto datatype = static_cast<dai::DatatypeEnum>(readIntLE(packet + size - 8));
+    if(datatype != dai::DatatypeEnum::ImgDetections) throw std::runtime_error("Packet doesn't hold an ImgDetections message");
+    if(metadataSize < 0 || static_cast<std::size_t>(metadataSize) > size - 8) throw std::runtime_error("Packet metadata size out of bounds");
+    return ImgDetectionsView(packet + size - 8 - metadataSize, static_cast<std::size_t>(metadataSize));
+}
+
+std::size_t ImgDetectionsView::decode(std::size_t offset, dai::ImgDetection& detection) const {
+    NopReader reader(data, dataSize, offset);
+    reader.readStructure(imgDetectionMembers);
+    detection.label = static_cast<std::uint32_t>(reader.readUnsigned());
+    detection.confidence = reader.readFloat();
+    detection.xmin = reader.readFloat();
+    detection.ymin = reader.readFloat();
+    detection.xmax = reader.readFloat();
+    detection.ymax = reader.readFloat();
+    return reader.position();
+}
+
+ImgDetectionsView::Iterator::Iterator(const ImgDetectionsView* view, std::size_t index, std::size_t offset) : view(view), index(index), next(offset) {
+    if(index < view->count) next = view->decode(next, current);
+}
+
+ImgDetectionsView::Iterator& ImgDetectionsView::Iterator::operator++() {
+    if(++index < view->count) next = view->decode(next, current);
+    return *this;
+}
@@ -0,0 +1,96 @@
+#ifndef DEPTHAI_ANDROID_JNI_EXAMPLE_DETECTIONS_VIEW_H
+#define DEPTHAI_ANDROID_JNI_EXAMPLE_DETECTIONS_VIEW_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#include "depthai-shared/datatype/RawImgDetections.hpp"
+
+// Read-only view over the nop encoded metadata of an ImgDetections message.
+// The layout is validated once (with bounds checks) in the constructor, the detections are then
+// decoded one at a time while iterating, so reading a message doesn't allocate.
+// The bytes must outlive the view.
+class ImgDetectionsView {
+   public:
+    class Iterator {
+       public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = dai::ImgDetection;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const dai::ImgDetection*;
+        using reference = const dai::ImgDetection&;
+
+        reference operator*() const {
+            return current;
+        }
+        pointer operator->() const {
+            return &current;
+        }
+        Iterator& operator++();
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+        bool operator==(const Iterator& other) const {
+            return index == other.index;
+        }
+        bool operator!=(const Iterator& other) const {
+            return index != other.index;
+        }
+
+       private:
+        friend class ImgDetectionsView;
+        Iterator(const ImgDetectionsView* view, std::size_t index, std::size_t offset);
+
+        const ImgDetectionsView* view;
+        std::size_t index;
+        std::size_t next;
+        dai::ImgDetection current;
+    };
+
+    // Serialized RawImgDetections, throws std::runtime_error if it is malformed or truncated
+    ImgDetectionsView(const std::uint8_t* data, std::size_t size);
+
+    // Whole XLink packet as sent by an XLinkOut node: payload, metadata, datatype and metadata size.
+    // Throws std::runtime_error if it doesn't hold an ImgDetections message.
+    static ImgDetectionsView fromPacket(const std::uint8_t* packet, std::size_t size);
+
+    std::size_t size() const {
+        return count;
+    }
+    bool empty() const {
+        return count == 0;
+    }
+    Iterator begin() const {
+        return Iterator(this, 0, first);
+    }
+    Iterator end() const {
+        return Iterator(this, count, 0);
+    }
+
+    std::int64_t getSequenceNum() const {
+        return sequenceNum;
+    }
+    const dai::Timestamp& getTimestamp() const {
+        return ts;
+    }
+    const dai::Timestamp& getTimestampDevice() const {
+        return tsDevice;
+    }
+
+   private:
+    // Decodes the detection at offset, returns the offset of the next one
+    std::size_t decode(std::size_t offset, dai::ImgDetection& detection) const;
+
+    const std::uint8_t* data;
+    std::size_t dataSize;
+    std::size_t first = 0;
+    std::size_t count = 0;
+    std::int64_t sequenceNum = 0;
+    dai::Timestamp ts;
+    dai::Timestamp tsDevice;
+};
+
+#endif //DEPTHAI_ANDROID_JNI_EXAMPLE_DETECTIONS_VIEW_H
@@ -0,0 +1,84 @@
+// Reading the detections of an ImgDetections message once, as draw_detections does, with 10, 100 and 1000
+// detections: ImgDetectionsView over the metadata bytes against what StreamMessageParser does for every
+// message (a new RawImgDetections filled by dai::utility::deserialize).
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "allocation_counter.h"
+#include "benchmark.h"
+#include "check.h"
+#include "depthai-shared/datatype/RawImgDetections.hpp"
+#include "detections_view.h"
+
+namespace {
+
+std::vector<std::uint8_t> makeMetadata(size_t count) {
+    dai::RawImgDetections detections;
+    for(size_t i = 0; i < count; i++) {
+        dai::ImgDetection detection;
+        detection.label = static_cast<uint32_t>(i % 80);
+        detection.confidence = 0.5f + static_cast<float>(i % 50) / 100.0f;
+        detection.xmin = 0.1f;
+        detection.ymin = 0.2f;
+        detection.xmax = 0.3f;
+        detection.ymax = 0.4f;
+        detections.detections.push_back(detection);
+    }
+    detections.sequenceNum = 42;
+    return dai::utility::serialize(detections);
+}
+
+// What a consumer reads from each detection
+template <typename Detections>
+float sum(const Detections& detections) {
+    float total = 0.0f;
+    for(const auto& detection : detections) {
+        total += detection.label + detection.confidence + detection.xmin + detection.ymin + detection.xmax + detection.ymax;
+    }
+    return total;
+}
+
+float readDeserialized(const std::vector<std::uint8_t>& metadata) {
+    auto detections = std::make_shared<dai::RawImgDetections>();
+    dai::utility::deserialize(metadata, *detections);
+    return sum(detections->detections);
+}
+
+float readView(const std::vector<std::uint8_t>& metadata) {
+    ImgDetectionsView view(metadata.data(), metadata.size());
+    return sum(view);
+}
+
+template <typename Read>
+void run(const char* name, size_t count, const std::vector<std::uint8_t>& metadata, Read read) {
+    char label[64];
+    std::snprintf(label, sizeof(label), "%s/%zu", name, count);
+    runBenchmark(label, static_cast<double>(count), "detections", [&]() { doNotOptimize(read(metadata)); });
+
+    AllocationCount begin = allocationCount();
+    doNotOptimize(read(metadata));
+    AllocationCount used = allocationCount() - begin;
+    std::printf("    %llu allocations (%llu bytes) per message\n", static_cast<unsigned long long>(used.allocations),
+                static_cast<unsigned long long>(used.bytes));
+}
+
+}  // namespace
+
+int main() {
+    for(size_t count : {10, 100, 1000}) {
+        std::vector<std::uint8_t> metadata = makeMetadata(count);
+
+        // Both read the same detections
+        dai::RawImgDetections expected;
+        dai::utility::deserialize(metadata, expected);
+        ImgDetectionsView view(metadata.data(), metadata.size());
+        CHECK(view.size() == count && view.getSequenceNum() == 42);
+        CHECK(sum(view) == sum(expected.detections));
+
+        run("deserialize", count, metadata, readDeserialized);
+        run("ImgDetectionsView", count, metadata, readView);
+    }
+    return 0;
+}
@@ -0,0 +1,112 @@
+// DeviceCapabilities against a fake device that counts its RPCs: query() makes each one once, reading the
+// snapshot afterwards (as the frame loop does) makes none, and a failing calibration read of any exception
+// type leaves the device uncalibrated instead of escaping.
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "check.h"
+#include "depthai-shared/common/EepromData.hpp"
+#include "device_capabilities.h"
+
+namespace {
+
+struct FakeCalibration {
+    dai::EepromData eeprom;
+    dai::EepromData getEepromData() const {
+        return eeprom;
+    }
+};
+
+// The dai::Device getters query() uses, each call counts as one RPC
+class FakeDevice {
+   public:
+    enum class Calibration { STORED, MISSING, PARSE_ERROR };
+
+    FakeDevice(std::vector<dai::CameraBoardSocket> cameras, Calibration calibration) : cameras(std::move(cameras)), calibration(calibration) {}
+
+    std::string getMxId() {
+        rpcs++;
+        return "14442C10D13EABCE00";
+    }
+    std::vector<dai::CameraBoardSocket> getConnectedCameras() {
+        rpcs++;
+        return cameras;
+    }
+    std::unordered_map<dai::CameraBoardSocket, std::string> getCameraSensorNames() {
+        rpcs++;
+        std::unordered_map<dai::CameraBoardSocket, std::string> names;
+        for(auto camera : cameras) names[camera] = camera == dai::CameraBoardSocket::RGB ? "IMX378" : "OV9282";
+        return names;
+    }
+    dai::UsbSpeed getUsbSpeed() {
+        rpcs++;
+        return dai::UsbSpeed::HIGH;
+    }
+    FakeCalibration readCalibration() {
+        rpcs++;
+        FakeCalibration result;
+        switch(calibration) {
+            case Calibration::STORED:
+                result.eeprom.boardName = "BW1098OBC";
+                result.eeprom.cameraData[dai::CameraBoardSocket::RGB] = dai::CameraInfo();
+                break;
+            case Calibration::MISSING:
+                throw std::runtime_error("No calibration stored");
+            case Calibration::PARSE_ERROR:
+                // What the JSON parsing of an older EEPROM layout throws, not a runtime_error
+                throw std::out_of_range("key 'boardName' not found");
+        }
+        return result;
+    }
+
+    int rpcs = 0;
+
+   private:
+    std::vector<dai::CameraBoardSocket> cameras;
+    Calibration calibration;
+};
+
+const int rpcsPerQuery = 5;
+const int framesRead = 1000;
+
+void testOakD() {
+    FakeDevice device({dai::CameraBoardSocket::RGB, dai::CameraBoardSocket::LEFT, dai::CameraBoardSocket::RIGHT}, FakeDevice::Calibration::STORED);
+    DeviceCapabilities capabilities = DeviceCapabilities::query(device);
+    CHECK(device.rpcs == rpcsPerQuery);
+
+    CHECK(capabilities.mxId == "14442C10D13EABCE00");
+    CHECK(capabilities.usbSpeed == dai::UsbSpeed::HIGH);
+    CHECK(capabilities.sensorNames.size() == 3);
+    CHECK(capabilities.calibrated && capabilities.boardName == "BW1098OBC");
+
+    // Per frame checks read the snapshot only
+    int stereoFrames = 0;
+    for(int i = 0; i < framesRead; i++) {
+        if(capabilities.hasStereo() && capabilities.hasCamera(dai::CameraBoardSocket::RGB)) stereoFrames++;
+    }
+    CHECK(stereoFrames == framesRead);
+    CHECK(device.rpcs == rpcsPerQuery);
+    std::printf("OAK-D: %d RPCs for the query, none for %d frames\n", device.rpcs, framesRead);
+}
+
+void testUncalibrated(FakeDevice::Calibration calibration) {
+    FakeDevice device({dai::CameraBoardSocket::RGB}, calibration);
+    DeviceCapabilities capabilities = DeviceCapabilities::query(device);
+    CHECK(device.rpcs == rpcsPerQuery);
+    CHECK(!capabilities.calibrated && capabilities.boardName.empty());
+    CHECK(!capabilities.hasStereo());
+    CHECK(capabilities.hasCamera(dai::CameraBoardSocket::RGB));
+}
+
+}  // namespace
+
+int main() {
+    testOakD();
+    testUncalibrated(FakeDevice::Calibration::MISSING);
+    testUncalibrated(FakeDevice::Calibration::PARSE_ERROR);
+    return 0;
+}
@@ -0,0 +1,165 @@
+// Compares every colorize kernel set this CPU supports with the scalar one, for all colormaps, all 256
+// RAW8 inputs and lengths around the vector widths (tails) at unaligned pointers. The rainbow table is
+// also checked bit for bit against colorDisparity, the per pixel function it replaced. RAW16 values above
+// the maximum disparity take the color of the first level above it, and an unconfigured colorizer throws.
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "check.h"
+#include "disparity_colorizer.h"
+
+namespace {
+
+const uint8_t guard = 0xA5;
+std::mt19937 random(1);
+
+const Colormap colormaps[] = {Colormap::RAINBOW, Colormap::JET, Colormap::TURBO, Colormap::GRAY};
+
+// The former per pixel colorization, a little endian ARGB int (Bitmap.setPixels)
+int colorDisparity(uint8_t disparity, float max_disparity) {
+    int r, g, b;
+
+    auto a = (1.0f - (float)disparity / max_disparity) * 5.0f;
+    auto X = (int)floor(a);
+    auto Y = (int)(255 * (a - X));
+    switch(X) {
+        case 0: r = 255; g = Y; b = 0; break;
+        case 1: r = 255 - Y; g = 255; b = 0; break;
+        case 2: r = 0; g = 255; b = Y; break;
+        case 3: r = 0; g = 255 - Y; b = 255; break;
+        case 4: r = Y; g = 0; b = 255; break;
+        case 5: r = 255; g = 0; b = 255; break;
+        default: r = 0; g = 0; b = 0; break;
+    }
+
+    return 255 << 24 | (r << 16) | (g << 8) | b;
+}
+
+// Lengths around every multiple of the vector widths (8 and 16 pixels) plus an odd frame width
+std::vector<size_t> testLengths() {
+    std::vector<size_t> lengths;
+    for(size_t i = 0; i <= 70; i++) lengths.push_back(i);
+    for(size_t length : {255, 256, 257, 641}) lengths.push_back(length);
+    return lengths;
+}
+
+// Every value once, then random ones, so all of them also show up in the vector part of each length
+template <typename T>
+std::vector<T> testValues(size_t count, unsigned maxValue) {
+    std::vector<T> values(count);
+    std::uniform_int_distribution<unsigned> distribution(0, maxValue);
+    for(size_t i = 0; i < count; i++) values[i] = static_cast<T>(i <= maxValue ? i : distribution(random));
+    return values;
+}
+
+template <typename T>
+void testKernels(const DisparityColorizer& colorizer, const ColorizeKernels& kernels, const ColorizeKernels& scalar, unsigned maxValue) {
+    for(size_t pixels : testLengths()) {
+        for(size_t offset = 0; offset < 4; offset++) {
+            std::vector<T> src = testValues<T>(pixels + offset, maxValue);
+            const T* in = src.data() + offset;
+
+            std::vector<uint8_t> expected(pixels * 4);
+            colorizer.colorize(in, expected.data(), pixels, scalar);
+
+            std::vector<uint8_t> dst(pixels * 4 + offset + 16, guard);
+            colorizer.colorize(in, dst.data() + offset, pixels, kernels);
+
+            CHECK(std::equal(expected.begin(), expected.end(), dst.begin() + offset));
+            for(size_t i = 0; i < offset; i++) CHECK(dst[i] == guard);
+            for(size_t i = offset + pixels * 4; i < dst.size(); i++) CHECK(dst[i] == guard);
+        }
+    }
+}
+
+// Standard (95) and extended (190) disparity, all 256 RAW8 values
+void testRainbowMatchesColorDisparity() {
+    std::vector<uint8_t> values = testValues<uint8_t>(256, 255);
+    for(float maxDisparity : {95.0f, 190.0f}) {
+        DisparityColorizer colorizer;
+        colorizer.configure(maxDisparity, Colormap::RAINBOW);
+        std::vector<uint8_t> dst(256 * 4);
+        colorizer.colorize(values.data(), dst.data(), values.size());
+        for(int d = 0; d < 256; d++) {
+            int argb = colorDisparity(static_cast<uint8_t>(d), maxDisparity);
+            const uint8_t* pixel = &dst[4 * d];
+            CHECK(pixel[0] == ((argb >> 16) & 0xFF) && pixel[1] == ((argb >> 8) & 0xFF) && pixel[2] == (argb & 0xFF) && pixel[3] == 255);
+        }
+    }
+}
+
+// Subpixel disparities up to 65535, e.g. invalid or very close pixels, against the first level above the maximum
+void testRaw16AboveMaximum(const ColorizeKernels& kernels) {
+    const float maxDisparity = 760.0f;
+    std::vector<uint16_t> values;
+    for(unsigned d = 761; d <= 65535; d += 97) values.push_back(static_cast<uint16_t>(d));
+    values.push_back(65535);
+
+    for(Colormap colormap : colormaps) {
+        DisparityColorizer colorizer;
+        colorizer.configure(maxDisparity, colormap);
+        uint16_t firstAbove = 761;
+        uint8_t expected[4];
+        colorizer.colorize(&firstAbove, expected, 1, kernels);
+
+        std::vector<uint8_t> dst(values.size() * 4 + 16, guard);
+        colorizer.colorize(values.data(), dst.data(), values.size(), kernels);
+        for(size_t i = 0; i < values.size(); i++) CHECK(std::memcmp(&dst[4 * i], expected, 4) == 0);
+        for(size_t i = values.size() * 4; i < dst.size(); i++) CHECK(dst[i] == guard);
+
+        // Beyond the short rainbow is black, the other colormaps stay at their end color
+        if(colormap == Colormap::RAINBOW) CHECK(expected[0] == 0 && expected[1] == 0 && expected[2] == 0 && expected[3] == 255);
+        if(colormap == Colormap::GRAY) CHECK(expected[0] == 255 && expected[1] == 255 && expected[2] == 255);
+    }
+}
+
+void testUnconfiguredThrows() {
+    DisparityColorizer colorizer;
+    uint8_t raw8 = 10;
+    uint16_t raw16 = 10;
+    uint8_t dst[4];
+    bool threw = false;
+    try {
+        colorizer.colorize(&raw8, dst, 1);
+    } catch(const std::runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+    threw = false;
+    try {
+        colorizer.colorize(&raw16, dst, 1);
+    } catch(const std::runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+}  // namespace
+
+int main() {
+    std::vector<ColorizeKernels> available = availableColorizeKernels();
+    const ColorizeKernels& scalar = available.back();
+    for(const ColorizeKernels& kernels : available) {
+        std::printf("Testing %s kernels\n", kernels.name);
+        for(Colormap colormap : colormaps) {
+            DisparityColorizer raw8;
+            raw8.configure(95.0f, colormap);
+            testKernels<uint8_t>(raw8, kernels, scalar, 255);
+
+            // Subpixel disparity with 3 fractional bits
+            DisparityColorizer raw16;
+            raw16.configure(760.0f, colormap);
+            testKernels<uint16_t>(raw16, kernels, scalar, 760);
+        }
+        testRaw16AboveMaximum(kernels);
+    }
+    testRainbowMatchesColorDisparity();
+    testUnconfiguredThrows();
+    std::printf("Passed\n");
+    return 0;
+}
@@ -0,0 +1,227 @@
+// Streams 10k synthetic RawImgFrames of each supported type through FrameConverter and checks that once the
+// ring is sized for a format, neither convert() nor convertToRgba() allocates. Also checks the RGBA pixels
+// of the rgb, gray and RAW16 types against the source, and that unsupported types are rejected.
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "opencv2/core.hpp"
+
+#include "allocation_counter.h"
+#include "check.h"
+#include "frame_converter.h"
+
+namespace {
+
+using Type = dai::RawImgFrame::Type;
+
+const unsigned int width = 64;
+const unsigned int height = 48;
+// Rows padded like the aligned frames of ImageManip
+const unsigned int padding = 16;
+const int framesPerType = 10000;
+
+// Bytes of pixel data in a row of the first plane, and the number of rows of all planes together
+void layout(Type type, unsigned int& rowBytes, unsigned int& rows) {
+    switch(type) {
+        case Type::RGB888i:
+        case Type::BGR888i:
+            rowBytes = width * 3;
+            rows = height;
+            return;
+        case Type::RGB888p:
+        case Type::BGR888p:
+            rowBytes = width;
+            rows = height * 3;
+            return;
+        case Type::NV12:
+        case Type::NV21:
+        case Type::YUV420p:
+            rowBytes = width;
+            rows = height * 3 / 2;
+            return;
+        case Type::RAW16:
+        case Type::GRAYF16:
+            rowBytes = width * 2;
+            rows = height;
+            return;
+        default:
+            rowBytes = width;
+            rows = height;
+            return;
+    }
+}
+
+dai::RawImgFrame makeFrame(Type type, bool padded, uint8_t seed) {
+    unsigned int rowBytes = 0, rows = 0;
+    layout(type, rowBytes, rows);
+    unsigned int stride = padded ? rowBytes + padding : rowBytes;
+
+    dai::RawImgFrame frame;
+    frame.fb.type = type;
+    frame.fb.width = width;
+    frame.fb.height = height;
+    frame.fb.stride = padded ? stride : 0;
+    if(type == Type::YUV420p && padded) {
+        // Chroma planes with half the luma stride
+        frame.fb.p2Offset = stride * height;
+        frame.fb.p3Offset = frame.fb.p2Offset + stride / 2 * height / 2;
+        frame.data.resize(frame.fb.p3Offset + stride / 2 * height / 2);
+    } else {
+        frame.data.resize(stride * rows);
+    }
+    for(size_t i = 0; i < frame.data.size(); i++) frame.data[i] = static_cast<uint8_t>(i * 7 + seed);
+    return frame;
+}
+
+// Source rgb of pixel (x, y) in the planar and interleaved rgb types
+void sourcePixel(const dai::RawImgFrame& frame, unsigned int x, unsigned int y, uint8_t rgb[3]) {
+    bool padded = frame.fb.stride != 0;
+    switch(frame.fb.type) {
+        case Type::RGB888i:
+        case Type::BGR888i: {
+            unsigned int stride = padded ? width * 3 + padding : width * 3;
+            const uint8_t* pixel = frame.data.data() + y * stride + x * 3;
+            bool bgr = frame.fb.type == Type::BGR888i;
+            for(int c = 0; c < 3; c++) rgb[c] = pixel[bgr ? 2 - c : c];
+        } break;
+        case Type::RGB888p:
+        case Type::BGR888p: {
+            unsigned int stride = padded ? width + padding : width;
+            bool bgr = frame.fb.type == Type::BGR888p;
+            for(int c = 0; c < 3; c++) rgb[c] = frame.data[(bgr ? 2 - c : c) * stride * height + y * stride + x];
+        } break;
+        default:
+            CHECK(false);
+    }
+}
+
+void testPixels(FrameConverter& converter, Type type, bool padded) {
+    dai::RawImgFrame frame = makeFrame(type, padded, 3);
+    std::vector<uint8_t> rgba(width * height * 4);
+    converter.convertToRgba(frame, rgba.data());
+    cv::Mat rgb = converter.convert(frame);
+    CHECK(rgb.type() == CV_8UC3 && rgb.rows == static_cast<int>(height) && rgb.cols == static_cast<int>(width));
+
+    for(unsigned int y = 0; y < height; y++) {
+        for(unsigned int x = 0; x < width; x++) {
+            uint8_t expected[3];
+            sourcePixel(frame, x, y, expected);
+            const uint8_t* pixel = rgba.data() + (y * width + x) * 4;
+            const uint8_t* converted = rgb.ptr<uint8_t>(static_cast<int>(y)) + x * 3;
+            for(int c = 0; c < 3; c++) {
+                CHECK(pixel[c] == expected[c]);
+                CHECK(converted[c] == expected[c]);
+            }
+            CHECK(pixel[3] == 255);
+        }
+    }
+}
+
+void testGrayPixels(FrameConverter& converter, Type type, bool padded) {
+    dai::RawImgFrame frame = makeFrame(type, padded, 5);
+    unsigned int stride = padded ? width + padding : width;
+    std::vector<uint8_t> rgba(width * height * 4);
+    converter.convertToRgba(frame, rgba.data());
+    for(unsigned int y = 0; y < height; y++) {
+        for(unsigned int x = 0; x < width; x++) {
+            uint8_t value = frame.data[y * stride + x];
+            const uint8_t* pixel = rgba.data() + (y * width + x) * 4;
+            CHECK(pixel[0] == value && pixel[1] == value && pixel[2] == value && pixel[3] == 255);
+        }
+    }
+}
+
+void testRaw16Pixels(FrameConverter& converter, const DisparityColorizer& colorizer, bool padded) {
+    dai::RawImgFrame frame = makeFrame(Type::RAW16, padded, 7);
+    unsigned int stride = padded ? width * 2 + padding : width * 2;
+    std::vector<uint8_t> rgba(width * height * 4);
+    converter.convertToRgba(frame, rgba.data());
+    for(unsigned int y = 0; y < height; y++) {
+        std::vector<uint16_t> row(width);
+        std::memcpy(row.data(), frame.data.data() + y * stride, width * 2);
+        std::vector<uint8_t> expected(width * 4);
+        colorizer.colorize(row.data(), expected.data(), width);
+        CHECK(std::memcmp(rgba.data() + y * width * 4, expected.data(), expected.size()) == 0);
+    }
+}
+
+bool rejected(FrameConverter& converter, Type type) {
+    dai::RawImgFrame frame = makeFrame(type, false, 0);
+    std::vector<uint8_t> rgba(width * height * 4);
+    try {
+        converter.convertToRgba(frame, rgba.data());
+    } catch(const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+void testAllocations(FrameConverter& converter, Type type, bool padded) {
+    // Two frames alternating, so the data differs from one conversion to the next
+    dai::RawImgFrame frames[2] = {makeFrame(type, padded, 1), makeFrame(type, padded, 2)};
+    std::vector<uint8_t> rgba(width * height * 4);
+
+    // The first conversions of a format size the ring slots
+    for(int i = 0; i < 4; i++) {
+        converter.convert(frames[i % 2]);
+        converter.convertToRgba(frames[i % 2], rgba.data());
+    }
+
+    AllocationCount begin = allocationCount();
+    for(int i = 0; i < framesPerType; i++) {
+        if(i % 2) {
+            converter.convert(frames[i % 2]);
+        } else {
+            converter.convertToRgba(frames[i % 2], rgba.data());
+        }
+    }
+    AllocationCount used = allocationCount() - begin;
+    std::printf("type %d%s: %llu allocations (%llu bytes) in %d frames\n", static_cast<int>(type), padded ? " padded" : "",
+                static_cast<unsigned long long>(used.allocations), static_cast<unsigned long long>(used.bytes), framesPerType);
+    CHECK(used.allocations == 0);
+}
+
+}  // namespace
+
+int main() {
+    // Runs the OpenCV conversions on this thread, the thread pool's own bookkeeping isn't what is measured
+    cv::setNumThreads(0);
+
+    FrameConverter converter;
+    const Type rgbTypes[] = {Type::RGB888p, Type::BGR888p, Type::RGB888i, Type::BGR888i};
+    for(Type type : rgbTypes) {
+        testPixels(converter, type, false);
+        testPixels(converter, type, true);
+    }
+
+    for(Type type : {Type::GRAY8, Type::RAW8}) {
+        testGrayPixels(converter, type, false);
+        testGrayPixels(converter, type, true);
+    }
+
+    // RAW16 needs a configured colorizer
+    CHECK(rejected(converter, Type::RAW16));
+    DisparityColorizer colorizer;
+    converter.setDisparityColorizer(&colorizer);
+    CHECK(rejected(converter, Type::RAW16));
+    colorizer.configure(760.0f, Colormap::TURBO);
+    testRaw16Pixels(converter, colorizer, false);
+    testRaw16Pixels(converter, colorizer, true);
+
+    // No RGBA conversion for float, bitstream or bayer frames
+    for(Type type : {Type::GRAYF16, Type::RGBF16F16F16i, Type::BITSTREAM, Type::RAW10}) {
+        CHECK(rejected(converter, type));
+    }
+
+    const Type types[] = {Type::RGB888p, Type::BGR888p, Type::RGB888i, Type::BGR888i, Type::NV12,  Type::NV21,
+                          Type::YUV420p, Type::GRAY8,   Type::RAW8,    Type::RAW16};
+    for(Type type : types) {
+        testAllocations(converter, type, false);
+        testAllocations(converter, type, true);
+    }
+    std::printf("Passed\n");
+    return 0;
+}
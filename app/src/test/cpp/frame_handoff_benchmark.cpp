@@ -0,0 +1,98 @@
+// Per frame cost of handing an rgb preview (BGR888p, as the camera sends it) to a Bitmap.
+//
+// before: the old imageFromJNI. imgframeToCvMat merged the planes into a new interleaved Mat, cvMatToBmpArray
+//         packed it pixel by pixel into a new int[] (NewIntArray) and Java copied that with Bitmap.setPixels.
+// after:  FrameConverter packs the planes straight into a slot of the frame pool and Java copies the slot
+//         with Bitmap.copyPixelsFromBuffer.
+//
+// The Java side copy is a memcpy into a bitmap sized buffer. Get/ReleaseIntArrayElements copy the int[]
+// twice more on a VM that moves arrays, that isn't counted in the before numbers.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "allocation_counter.h"
+#include "benchmark.h"
+#include "frame_slots.h"
+#include "pixel_pack.h"
+
+namespace {
+
+int copies = 0;
+
+template <typename Body>
+void measure(const char* name, size_t pixels, Body body) {
+    double seconds = runBenchmark(name, static_cast<double>(pixels), "pixels", body);
+
+    const int frames = 100;
+    copies = 0;
+    AllocationCount begin = allocationCount();
+    for(int i = 0; i < frames; i++) body();
+    AllocationCount used = allocationCount() - begin;
+    std::printf("    %.1f frame copies, %.1f allocations (%.2f MB) per frame, %.1f MB allocated per second\n", copies / double(frames),
+                used.allocations / double(frames), used.bytes / double(frames) / 1e6, used.bytes / double(frames) / seconds / 1e6);
+}
+
+void run(size_t width, size_t height) {
+    const size_t pixels = width * height;
+    std::vector<uint8_t> planes(pixels * 3);
+    std::mt19937 random(42);
+    for(auto& value : planes) value = static_cast<uint8_t>(random());
+    const uint8_t* b = planes.data();
+    const uint8_t* g = b + pixels;
+    const uint8_t* r = g + pixels;
+    std::vector<uint8_t> bitmap(pixels * 4);
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "handoff/before/%zux%zu", width, height);
+    measure(name, pixels, [&]() {
+        // imgframeToCvMat: cv::merge into a new Mat
+        std::unique_ptr<uint8_t[]> rgb(new uint8_t[pixels * 3]);
+        for(size_t i = 0; i < pixels; i++) {
+            rgb[3 * i] = r[i];
+            rgb[3 * i + 1] = g[i];
+            rgb[3 * i + 2] = b[i];
+        }
+        copies++;
+
+        // cvMatToBmpArray: NewIntArray (zeroed) and the shifts per pixel
+        std::vector<int32_t> argb(pixels);
+        for(size_t i = 0; i < pixels; i++) {
+            argb[i] = 255 << 24 | (rgb[3 * i] << 16) | (rgb[3 * i + 1] << 8) | rgb[3 * i + 2];
+        }
+        copies++;
+
+        // Bitmap.setPixels
+        std::memcpy(bitmap.data(), argb.data(), pixels * 4);
+        copies++;
+        doNotOptimize(bitmap.data());
+    });
+
+    FrameSlots slots(3, pixels * 4);
+    std::snprintf(name, sizeof(name), "handoff/after/%zux%zu", width, height);
+    measure(name, pixels, [&]() {
+        int slot = slots.acquire();
+        packPlanarToRgba(r, g, b, slots.data(slot), pixels);
+        copies++;
+        slots.publish(slot);
+
+        // Bitmap.copyPixelsFromBuffer, then the slot goes back to the pool
+        std::memcpy(bitmap.data(), slots.data(slot), pixels * 4);
+        copies++;
+        slots.release(slot);
+        doNotOptimize(bitmap.data());
+    });
+}
+
+}  // namespace
+
+int main() {
+    std::printf("Pixel pack kernel: %s\n", packKernelName());
+    run(416, 416);
+    run(1920, 1080);
+    return 0;
+}
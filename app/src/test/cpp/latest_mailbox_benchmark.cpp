@@ -0,0 +1,85 @@
+// Age of a frame when the consumer takes it (pop time - push time), for the queues the preview streams
+// could use: LatestMailbox, the LockingQueue(1, false) it replaced, and a LockingQueue(4, false) for
+// reference. The producer is a camera pushing a frame every framePeriod, the consumer a render loop
+// popping at most one frame per tick, once faster (2x) and once slower (1/2x) than the camera.
+// Time is scaled down (1 ms frames) so a run takes seconds, the ages scale with it.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "depthai/utility/LockingQueue.hpp"
+#include "latest_mailbox.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Frame {
+    Clock::time_point pushed;
+};
+
+const std::chrono::microseconds framePeriod(1000);
+const int frames = 3000;
+
+// The mailbox has no size, it is constructed like the queue it replaces
+struct Mailbox : LatestMailbox<std::shared_ptr<Frame>> {
+    Mailbox(unsigned, bool) {}
+};
+
+template <typename Queue>
+void run(const char* name, unsigned maxSize, std::chrono::microseconds renderPeriod) {
+    Queue queue(maxSize, false);
+    std::atomic<bool> done{false};
+
+    std::thread camera([&]() {
+        auto next = Clock::now();
+        for(int i = 0; i < frames; i++) {
+            auto frame = std::make_shared<Frame>();
+            frame->pushed = Clock::now();
+            queue.push(frame);
+            next += framePeriod;
+            std::this_thread::sleep_until(next);
+        }
+        done = true;
+    });
+
+    std::vector<double> ages;
+    ages.reserve(frames);
+    auto next = Clock::now();
+    while(!done) {
+        std::shared_ptr<Frame> frame;
+        if(queue.tryPop(frame)) {
+            ages.push_back(std::chrono::duration<double, std::micro>(Clock::now() - frame->pushed).count());
+        }
+        next += renderPeriod;
+        std::this_thread::sleep_until(next);
+    }
+    camera.join();
+
+    auto percentile = [&ages](double p) {
+        auto nth = ages.begin() + static_cast<ptrdiff_t>(p * (ages.size() - 1));
+        std::nth_element(ages.begin(), nth, ages.end());
+        return *nth / 1e3;
+    };
+    std::printf("%-20s render %4.1f ms %6zu frames shown %8.3f ms p50 age %8.3f ms p99 age\n", name, renderPeriod.count() / 1e3, ages.size(),
+                percentile(0.5), percentile(0.99));
+}
+
+}  // namespace
+
+int main() {
+    using Ptr = std::shared_ptr<Frame>;
+    std::printf("frame period %.1f ms, %d frames\n", framePeriod.count() / 1e3, frames);
+    for(auto renderPeriod : {framePeriod / 2, framePeriod * 2}) {
+        run<Mailbox>("LatestMailbox", 1, renderPeriod);
+        run<dai::LockingQueue<Ptr>>("LockingQueue(1)", 1, renderPeriod);
+        run<dai::LockingQueue<Ptr>>("LockingQueue(4)", 4, renderPeriod);
+    }
+    return 0;
+}
@@ -0,0 +1,42 @@
+// Pixels per second of every kernel set this CPU supports, at the app's preview size and at 1080p
+
+#include <cstdio>
+#include <vector>
+
+#include "benchmark.h"
+#include "pixel_pack.h"
+
+int main() {
+    const size_t sizes[][2] = {{416, 416}, {1920, 1080}};
+
+    for(const auto& size : sizes) {
+        const size_t pixels = size[0] * size[1];
+        std::vector<uint8_t> src(pixels * 3, 7);
+        std::vector<uint8_t> dst(pixels * 4);
+        const uint8_t* r = src.data();
+        const uint8_t* g = r + pixels;
+        const uint8_t* b = g + pixels;
+
+        for(const PackKernels& kernels : availablePackKernels()) {
+            char name[64];
+            std::snprintf(name, sizeof(name), "interleaved_rgb/%s/%zux%zu", kernels.name, size[0], size[1]);
+            runBenchmark(name, static_cast<double>(pixels), "pixels", [&]() {
+                kernels.interleaved(src.data(), dst.data(), pixels, PixelOrder::RGB);
+                doNotOptimize(dst.data());
+            });
+
+            std::snprintf(name, sizeof(name), "interleaved_bgr/%s/%zux%zu", kernels.name, size[0], size[1]);
+            runBenchmark(name, static_cast<double>(pixels), "pixels", [&]() {
+                kernels.interleaved(src.data(), dst.data(), pixels, PixelOrder::BGR);
+                doNotOptimize(dst.data());
+            });
+
+            std::snprintf(name, sizeof(name), "planar/%s/%zux%zu", kernels.name, size[0], size[1]);
+            runBenchmark(name, static_cast<double>(pixels), "pixels", [&]() {
+                kernels.planar(r, g, b, dst.data(), pixels);
+                doNotOptimize(dst.data());
+            });
+        }
+    }
+    return 0;
+}
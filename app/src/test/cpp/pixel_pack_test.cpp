@@ -0,0 +1,126 @@
+// Compares every vector kernel set this CPU supports with the scalar reference, for all lengths
+// around the vector widths (tails), unaligned pointers and padded image rows.
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "check.h"
+#include "pixel_pack.h"
+
+namespace {
+
+const uint8_t guard = 0xA5;
+std::mt19937 random(1);
+
+std::vector<uint8_t> randomBytes(size_t count) {
+    std::vector<uint8_t> bytes(count);
+    for(auto& byte : bytes) byte = static_cast<uint8_t>(random());
+    return bytes;
+}
+
+// Lengths around every multiple of the vector widths (4, 8, 16 and 32 pixels) plus some odd frame sizes
+std::vector<size_t> testLengths() {
+    std::vector<size_t> lengths;
+    for(size_t i = 0; i <= 100; i++) lengths.push_back(i);
+    for(size_t length : {127, 128, 129, 255, 256, 257, 1023, 4097, 416 * 3 + 1}) lengths.push_back(length);
+    return lengths;
+}
+
+void testInterleaved(const PackKernels& kernels, PixelOrder order) {
+    for(size_t pixels : testLengths()) {
+        for(size_t offset = 0; offset < 4; offset++) {
+            // The source ends exactly at the end of its buffer, so over-reads show up under ASan
+            std::vector<uint8_t> src = randomBytes(pixels * 3 + offset);
+            const uint8_t* in = src.data() + offset;
+
+            std::vector<uint8_t> expected(pixels * 4);
+            packInterleavedToRgbaScalar(in, expected.data(), pixels, order);
+
+            std::vector<uint8_t> dst(pixels * 4 + offset + 16, guard);
+            kernels.interleaved(in, dst.data() + offset, pixels, order);
+
+            CHECK(std::equal(expected.begin(), expected.end(), dst.begin() + offset));
+            for(size_t i = 0; i < offset; i++) CHECK(dst[i] == guard);
+            for(size_t i = offset + pixels * 4; i < dst.size(); i++) CHECK(dst[i] == guard);
+        }
+    }
+}
+
+void testPlanar(const PackKernels& kernels) {
+    for(size_t pixels : testLengths()) {
+        for(size_t offset = 0; offset < 4; offset++) {
+            std::vector<uint8_t> r = randomBytes(pixels + offset), g = randomBytes(pixels + offset), b = randomBytes(pixels + offset);
+
+            std::vector<uint8_t> expected(pixels * 4);
+            packPlanarToRgbaScalar(r.data() + offset, g.data() + offset, b.data() + offset, expected.data(), pixels);
+
+            std::vector<uint8_t> dst(pixels * 4 + offset + 16, guard);
+            kernels.planar(r.data() + offset, g.data() + offset, b.data() + offset, dst.data() + offset, pixels);
+
+            CHECK(std::equal(expected.begin(), expected.end(), dst.begin() + offset));
+            for(size_t i = 0; i < offset; i++) CHECK(dst[i] == guard);
+            for(size_t i = offset + pixels * 4; i < dst.size(); i++) CHECK(dst[i] == guard);
+        }
+    }
+}
+
+void testGray() {
+    for(size_t pixels : testLengths()) {
+        std::vector<uint8_t> src = randomBytes(pixels);
+        std::vector<uint8_t> dst(pixels * 4 + 16, guard);
+        packGrayToRgba(src.data(), dst.data(), pixels);
+        for(size_t i = 0; i < pixels; i++) {
+            CHECK(dst[4 * i] == src[i] && dst[4 * i + 1] == src[i] && dst[4 * i + 2] == src[i] && dst[4 * i + 3] == 255);
+        }
+        for(size_t i = pixels * 4; i < dst.size(); i++) CHECK(dst[i] == guard);
+    }
+}
+
+// Runtime selected kernels through the image entry point, packed and with padded rows on both sides
+void testPlanarImage() {
+    const size_t widths[] = {1, 15, 17, 33, 416, 641};
+    const size_t heights[] = {1, 2, 7};
+    for(size_t width : widths) {
+        for(size_t height : heights) {
+            for(size_t srcPadding : {0, 3, 64}) {
+                for(size_t dstPadding : {0, 5}) {
+                    size_t srcStride = width + srcPadding;
+                    size_t dstStride = width * 4 + dstPadding;
+                    std::vector<uint8_t> planes = randomBytes(srcStride * height * 3);
+                    const uint8_t* r = planes.data();
+                    const uint8_t* g = r + srcStride * height;
+                    const uint8_t* b = g + srcStride * height;
+
+                    std::vector<uint8_t> dst(dstStride * height, guard);
+                    packPlanarImageToRgba(r, g, b, srcStride, width, height, dst.data(), dstStride);
+
+                    std::vector<uint8_t> expected(width * 4);
+                    for(size_t y = 0; y < height; y++) {
+                        const size_t offset = y * srcStride;
+                        packPlanarToRgbaScalar(r + offset, g + offset, b + offset, expected.data(), width);
+                        const uint8_t* row = dst.data() + y * dstStride;
+                        CHECK(std::equal(expected.begin(), expected.end(), row));
+                        for(size_t i = width * 4; i < dstStride; i++) CHECK(row[i] == guard);
+                    }
+                }
+            }
+        }
+    }
+}
+
+}  // namespace
+
+int main() {
+    for(const PackKernels& kernels : availablePackKernels()) {
+        std::printf("Testing %s kernels\n", kernels.name);
+        testInterleaved(kernels, PixelOrder::RGB);
+        testInterleaved(kernels, PixelOrder::BGR);
+        testPlanar(kernels);
+    }
+    testPlanarImage();
+    testGray();
+    std::printf("Passed\n");
+    return 0;
+}
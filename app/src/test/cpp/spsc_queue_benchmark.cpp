@@ -0,0 +1,107 @@
+// Messages per second and handoff latency (push to pop) of SpscQueue against dai::LockingQueue, the queue
+// it replaced in HostOutputQueue. Every stream has its own queue, filled by its XLink reading thread and
+// drained by the JNI caller, so N streams are N producer/consumer pairs on N queues running at once.
+// Messages are shared_ptrs like the ADatatypes of the app, taken from a preallocated ring so the
+// allocator isn't what is measured.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "depthai/utility/LockingQueue.hpp"
+#include "spsc_queue.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Message {
+    Clock::time_point pushed;
+};
+
+// Size of the output queues in the app
+const unsigned queueSize = 8;
+const int messagesPerPair = 200000;
+// More than a full queue plus the message being pushed and the one being consumed
+const size_t ringSize = 64;
+
+struct Result {
+    double messagesPerSecond;
+    double p50;
+    double p99;
+};
+
+template <typename Queue>
+Result run(int pairs) {
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::vector<uint32_t>> latencies(pairs);
+    for(int p = 0; p < pairs; p++) {
+        queues.emplace_back(new Queue(queueSize, true));
+        latencies[p].reserve(messagesPerPair);
+    }
+
+    std::vector<std::thread> threads;
+    auto begin = Clock::now();
+    for(int p = 0; p < pairs; p++) {
+        Queue& queue = *queues[p];
+        threads.emplace_back([&queue]() {
+            std::vector<std::shared_ptr<Message>> ring(ringSize);
+            for(auto& message : ring) message = std::make_shared<Message>();
+            for(int i = 0; i < messagesPerPair; i++) {
+                auto& message = ring[i % ringSize];
+                message->pushed = Clock::now();
+                queue.push(message);
+            }
+        });
+        std::vector<uint32_t>& latency = latencies[p];
+        threads.emplace_back([&queue, &latency]() {
+            std::shared_ptr<Message> message;
+            for(int i = 0; i < messagesPerPair; i++) {
+                queue.waitAndPop(message);
+                auto age = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - message->pushed).count();
+                latency.push_back(static_cast<uint32_t>(std::min<int64_t>(age, UINT32_MAX)));
+            }
+        });
+    }
+    for(auto& thread : threads) thread.join();
+    std::chrono::duration<double> elapsed = Clock::now() - begin;
+
+    std::vector<uint32_t> all;
+    all.reserve(static_cast<size_t>(pairs) * messagesPerPair);
+    for(const auto& latency : latencies) all.insert(all.end(), latency.begin(), latency.end());
+    auto percentile = [&all](double p) {
+        auto nth = all.begin() + static_cast<ptrdiff_t>(p * (all.size() - 1));
+        std::nth_element(all.begin(), nth, all.end());
+        return *nth / 1e3;
+    };
+
+    Result result;
+    result.messagesPerSecond = pairs * static_cast<double>(messagesPerPair) / elapsed.count();
+    result.p50 = percentile(0.50);
+    result.p99 = percentile(0.99);
+    return result;
+}
+
+template <typename Queue>
+void report(const char* name, int pairs) {
+    run<Queue>(pairs);  // warm up
+    Result result = run<Queue>(pairs);
+    std::printf("%-14s %d pairs %12.2f Mmsgs/s %10.2f us p50 %10.2f us p99\n", name, pairs, result.messagesPerSecond / 1e6, result.p50,
+                result.p99);
+}
+
+}  // namespace
+
+int main() {
+    using Ptr = std::shared_ptr<Message>;
+    std::printf("%u hardware threads, queue size %u, %d messages per pair\n", std::thread::hardware_concurrency(), queueSize, messagesPerPair);
+    for(int pairs : {1, 2, 4, 8}) {
+        report<dai::LockingQueue<Ptr>>("LockingQueue", pairs);
+        report<SpscQueue<Ptr>>("SpscQueue", pairs);
+    }
+    return 0;
+}
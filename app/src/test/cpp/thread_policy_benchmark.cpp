@@ -0,0 +1,67 @@
+// Wake-up jitter of a periodic thread, like an XLink reader waiting for the next frame, while every core
+// is busy with other work: with the default scheduling and with ThreadPolicy::fastCores() (big cores,
+// nice -8). The lateness of each wake-up (actual - scheduled time) is what shows up as frame latency jitter.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "benchmark.h"
+#include "thread_policy.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const std::chrono::microseconds period(1000);
+const int wakeUps = 3000;
+
+void run(const char* name, const ThreadPolicy* policy) {
+    // Two busy threads per core, so the periodic thread has to win the core back on every wake-up
+    std::atomic<bool> done{false};
+    std::vector<std::thread> load;
+    unsigned loadThreads = std::max(1u, std::thread::hardware_concurrency()) * 2;
+    for(unsigned i = 0; i < loadThreads; i++) {
+        load.emplace_back([&done]() {
+            unsigned value = 0;
+            while(!done.load(std::memory_order_relaxed)) doNotOptimize(value++);
+        });
+    }
+
+    std::vector<double> lateness;
+    lateness.reserve(wakeUps);
+    std::thread periodic([&]() {
+        if(policy && !applyThreadPolicy(*policy)) std::printf("    policy only partly applied\n");
+        auto next = Clock::now();
+        for(int i = 0; i < wakeUps; i++) {
+            next += period;
+            std::this_thread::sleep_until(next);
+            lateness.push_back(std::chrono::duration<double, std::micro>(Clock::now() - next).count());
+        }
+    });
+    periodic.join();
+    done = true;
+    for(auto& thread : load) thread.join();
+
+    auto percentile = [&lateness](double p) {
+        auto nth = lateness.begin() + static_cast<std::ptrdiff_t>(p * (lateness.size() - 1));
+        std::nth_element(lateness.begin(), nth, lateness.end());
+        return *nth;
+    };
+    std::printf("%-12s %u load threads %10.1f us p50 %10.1f us p99 %10.1f us max late\n", name, loadThreads, percentile(0.5), percentile(0.99),
+                percentile(1.0));
+}
+
+}  // namespace
+
+int main() {
+    ThreadPolicy fastCores = ThreadPolicy::fastCores();
+    std::printf("period %lld us, %d wake-ups, %zu fast cores\n", static_cast<long long>(period.count()), wakeUps, fastCores.cpus.size());
+    run("default", nullptr);
+    run("fastCores", &fastCores);
+    return 0;
+}